@@ -12,8 +12,21 @@ import java.nio.*;
 
 public class Generator {
     private ByteBuffer mS, mState, mBuf, mSeed = null;
-    private static int mStructSize;
-    static { mStructSize = nStructSize(); }
+    private long mBufAddr;
+    private int mBufBytes;
+
+    /* Layout of the C struct, so that buffered words can be had by reading
+     * the buffer and moving its pointer (bptr) here, with JNI only for the
+     * refill. The struct stays the one record of the buffer position, so
+     * the native calls that draw from it see the same stream.
+     */
+    private static int mStructSize, mBufOffset, mBufPtrOffset, mPointerSize;
+    static {
+        mStructSize = nStructSize();
+        mBufOffset = nBufOffset();
+        mBufPtrOffset = nBufPtrOffset();
+        mPointerSize = nPointerSize();
+    }
 
     public static int algorithmCount() { return nAlgorithmCount(); }
     public static int algorithmID(String name) { return nAlgorithmID(name); }
@@ -37,6 +50,7 @@ public class Generator {
 
     public Generator(int id) {
         mS = ByteBuffer.allocateDirect(mStructSize);
+        mS.order(ByteOrder.nativeOrder());
         nInit(mS);
         nSetAlgorithm(mS, id);
 
@@ -46,7 +60,10 @@ public class Generator {
 
         s = nAlgorithmBufSize(id);
         this.mBuf = ByteBuffer.allocateDirect(4 * s);
+        mBuf.order(ByteOrder.nativeOrder());
         nSetBuf(mS, mBuf, s);
+        mBufAddr = getPointer(mBufOffset);
+        mBufBytes = 4 * s;
         nCallOpen(mS);
         systemSeed(mS);
     }
@@ -57,6 +74,7 @@ public class Generator {
         ByteBuffer b = ByteBuffer.allocateDirect(4 * s.length);
         b.order(ByteOrder.LITTLE_ENDIAN);
         for (int i = 0; i < s.length; ++i) { b.putInt(4 * i, s[i]); }
+        setPointer(mBufPtrOffset, mBufAddr);
         nCallSeed(mS, b, s.length);
         nSetSeeded(mS, 1);
     }
@@ -65,6 +83,7 @@ public class Generator {
         ByteBuffer b = ByteBuffer.allocateDirect(4);
         b.order(ByteOrder.LITTLE_ENDIAN);
         b.putInt(0, s);
+        setPointer(mBufPtrOffset, mBufAddr);
         nCallSeed(mS, b, 1);
         nSetSeeded(mS, 1);
     }
@@ -78,10 +97,45 @@ public class Generator {
         nCallReseed(mS, b, s);
     }
     public int next16() { return nNext16(mS); }
-    public int next32() { return nNext32(mS); }
-    public long next64() { return nNext64(mS); }
 
-    public double nextDouble() { return nNextDouble(mS); }
+    private long getPointer(int offset) {
+        if (8 == mPointerSize) return mS.getLong(offset);
+        return mS.getInt(offset) & 0xFFFFFFFFL;
+    }
+    private void setPointer(int offset, long p) {
+        if (8 == mPointerSize) mS.putLong(offset, p);
+        else mS.putInt(offset, (int)p);
+    }
+
+    // Same as OJR_NEXT32(): words are handed out from the end of the buffer.
+    public int next32() {
+        long p = getPointer(mBufPtrOffset);
+        if (p == mBufAddr) {
+            nCallRefill(mS);
+            p = mBufAddr + mBufBytes;
+        }
+        p -= 4;
+        setPointer(mBufPtrOffset, p);
+        return mBuf.getInt((int)(p - mBufAddr));
+    }
+
+    // Same as OJR_NEXT64(): two words at once if there are two left.
+    public long next64() {
+        long p = getPointer(mBufPtrOffset);
+        if (p - mBufAddr < 8) {
+            long r = (long)next32() << 32;
+            return r | (next32() & 0xFFFFFFFFL);
+        }
+        p -= 8;
+        setPointer(mBufPtrOffset, p);
+        return mBuf.getLong((int)(p - mBufAddr));
+    }
+
+    // 52 bits scaled to [0,1), the same value ojr_next_double() makes.
+    public double nextDouble() {
+        return (next64() & 0xFFFFFFFFFFFFFL) * 0x1.0p-52;
+    }
+
     public double nextSignedDouble() { return nNextSignedDouble(mS); }
     public double nextNormal() { return nNextNormal(mS); }
     public double nextExponential() { return nNextExponential(mS); }
@@ -90,6 +144,9 @@ public class Generator {
     public void discard(int count) { nDiscard(mS, count); }
 
     private static native int nStructSize();
+    private static native int nBufOffset();
+    private static native int nBufPtrOffset();
+    private static native int nPointerSize();
     private static native void nInit(ByteBuffer b);
     private static native int nAlgorithmCount();
     private static native int nAlgorithmID(String name);
@@ -112,9 +169,6 @@ public class Generator {
     private static native void nCallRefill(ByteBuffer b);
 
     private static native int nNext16(ByteBuffer b);
-    private static native int nNext32(ByteBuffer b);
-    private static native long nNext64(ByteBuffer b);
-    private static native double nNextDouble(ByteBuffer b);
     private static native double nNextSignedDouble(ByteBuffer b);
     private static native double nNextNormal(ByteBuffer b);
     private static native double nNextExponential(ByteBuffer b);
@@ -6,6 +6,7 @@
  */
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <jni.h>
 
@@ -16,6 +17,24 @@ JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nStructSize
 	return sizeof(ojr_generator);
 }
 
+/* Where the buffer pointers are in the struct, so that Java can hand out
+ * buffered words itself and call in only to refill.
+ */
+JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nBufOffset
+(JNIEnv *env, jclass cls) {
+	return offsetof(ojr_generator, buf);
+}
+
+JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nBufPtrOffset
+(JNIEnv *env, jclass cls) {
+	return offsetof(ojr_generator, bptr);
+}
+
+JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nPointerSize
+(JNIEnv *env, jclass cls) {
+	return sizeof(uint32_t *);
+}
+
 JNIEXPORT void JNICALL Java_com_onejoker_randlib_Generator_nInit
 (JNIEnv *env, jclass cls, jobject b) {
     jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
@@ -132,24 +151,6 @@ JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nNext16
 	return ojr_next16((ojr_generator *)ptr);
 }
 
-JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nNext32
-(JNIEnv *env, jclass cls, jobject b) {
-    jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
-	return ojr_next32((ojr_generator *)ptr);
-}
-
-JNIEXPORT jlong JNICALL Java_com_onejoker_randlib_Generator_nNext64
-(JNIEnv *env, jclass cls, jobject b) {
-    jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
-	return ojr_next64((ojr_generator *)ptr);
-}
-
-JNIEXPORT jdouble JNICALL Java_com_onejoker_randlib_Generator_nNextDouble
-(JNIEnv *env, jclass cls, jobject b) {
-    jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
-	return ojr_next_double((ojr_generator *)ptr);
-}
-
 JNIEXPORT jdouble JNICALL Java_com_onejoker_randlib_Generator_nNextSignedDouble
 (JNIEnv *env, jclass cls, jobject b) {
     jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
@@ -165,7 +166,7 @@ JNIEXPORT jdouble JNICALL Java_com_onejoker_randlib_Generator_nNextNormal
 JNIEXPORT jdouble JNICALL Java_com_onejoker_randlib_Generator_nNextExponential
 (JNIEnv *env, jclass cls, jobject b) {
     jbyte *ptr = (*env)->GetDirectBufferAddress(env, b);
-    return ojr_next_normal((ojr_generator *)ptr);
+    return ojr_next_exponential((ojr_generator *)ptr);
 }
 
 JNIEXPORT jint JNICALL Java_com_onejoker_randlib_Generator_nRand
@@ -0,0 +1,118 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Walker's alias method, with Vose's O(n) construction, for choosing among
+ * weighted categories in constant time.
+ *
+ * The table is padded with zero-weight columns to a power of 2, so each
+ * draw is one 64-bit word: the low bits pick the column exactly, with no
+ * rejection, and the high 32 bits are compared to the column's threshold.
+ * Columns that never use their alias alias themselves, so a threshold of
+ * 0xFFFFFFFF is as good as 1.0.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+/* Build a table from <count> non-negative <weights>, which needn't be
+ * normalized. Returns NULL if none are positive or on allocation failure.
+ */
+ojr_alias *ojr_alias_new(double *weights, int count) {
+    int i, s, l, ns, nl, size, shift, *work;
+    double sum = 0.0, *p;
+    ojr_alias *ap;
+
+    assert(count > 0 && count <= 0x40000000);
+    for (i = 0; i < count; ++i) {
+        assert(weights[i] >= 0.0);
+        sum += weights[i];
+    }
+    if (! (sum > 0.0)) return NULL;
+    for (shift = 0, size = 1; size < count; ++shift) size <<= 1;
+
+    if (NULL == (ap = malloc(sizeof(ojr_alias)))) return NULL;
+    ap->table = malloc(size * sizeof(ojr_alias_entry));
+    p = malloc(size * sizeof(double));
+    work = malloc(size * sizeof(int));
+
+    if (NULL == ap->table || NULL == p || NULL == work) {
+        free(work);
+        free(p);
+        free(ap->table);
+        free(ap);
+        return NULL;
+    }
+    ap->count = count;
+    ap->size = size;
+    ap->shift = shift;
+
+    /* Scale so the average column is 1.0. Small columns are stacked from
+     * the bottom of <work> and large ones from the top.
+     */
+    ns = 0;
+    nl = size;
+    for (i = 0; i < size; ++i) {
+        p[i] = (i < count) ? weights[i] * size / sum : 0.0;
+        if (p[i] < 1.0) work[ns++] = i;
+        else work[--nl] = i;
+    }
+    while (ns > 0 && nl < size) {
+        s = work[--ns];
+        l = work[nl];
+
+        ap->table[s].threshold =
+            (p[s] > 0.0) ? (uint32_t)(p[s] * 4294967296.0) : 0;
+        ap->table[s].alias = l;
+
+        p[l] -= 1.0 - p[s];
+        if (p[l] < 1.0) {
+            ++nl;
+            work[ns++] = l;
+        }
+    }
+    // Whatever is left is 1.0 give or take rounding.
+    while (ns > 0) {
+        s = work[--ns];
+        ap->table[s].threshold = 0xFFFFFFFF;
+        ap->table[s].alias = s;
+    }
+    while (nl < size) {
+        l = work[nl++];
+        ap->table[l].threshold = 0xFFFFFFFF;
+        ap->table[l].alias = l;
+    }
+    free(work);
+    free(p);
+    return ap;
+}
+
+void ojr_alias_free(ojr_alias *ap) {
+    assert(NULL != ap);
+    free(ap->table);
+    free(ap);
+}
+
+static inline int alias(ojr_generator *g, const ojr_alias *ap) {
+    uint64_t r = OJR_NEXT64(g);
+    int col = (int)(r & (ap->size - 1));
+    const ojr_alias_entry *e = ap->table + col;
+
+    return ((uint32_t)(r >> 32) < e->threshold) ? col : (int)e->alias;
+}
+
+// Return index from 0 to count-1 with probability proportional to its weight.
+int ojr_next_alias(ojr_generator *g, ojr_alias *ap) {
+    return alias(g, ap);
+}
+
+void ojr_fill_alias(ojr_generator *g, ojr_alias *ap, int *a, int count) {
+    int i;
+    for (i = 0; i < count; ++i) a[i] = alias(g, ap);
+}
@@ -0,0 +1,132 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Bootstrap resampling: n indices from 0 to n-1 chosen with replacement,
+ * or just how many times each index was chosen. The counts are multinomial
+ * with equal weights, so they come from a chain of binomials, count i being
+ * binomial on the draws left over with probability 1/(n-i). That takes one
+ * or two uniforms per index, about as many as drawing indices, but needs no
+ * scattered increments into the count array.
+ *
+ * Fills of many replicates give each one its own substream seeded from the
+ * caller's generator, so the results don't depend on how many threads did
+ * the work. Threads are used if the library is built with OpenMP.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+#ifdef _OPENMP
+#  include <omp.h>
+#  define THREADNUM() omp_get_thread_num()
+#  define PARALLEL_FOR \
+    _Pragma("omp parallel for num_threads(nt) schedule(dynamic)")
+#else
+#  define THREADNUM() 0
+#  define PARALLEL_FOR
+#endif
+
+#define SEEDWORDS 4
+
+static void indices(ojr_generator *g, int64_t n, int64_t *out) {
+    int64_t i;
+    for (i = 0; i < n; ++i) out[i] = (int64_t)ojr_rand64(g, (uint64_t)n);
+}
+
+static void counts(ojr_generator *g, int64_t n, int64_t *out) {
+    int64_t i, left = n;
+    ojr_binomial bp;
+
+    for (i = 0; i < n - 1; ++i) {
+        if (0 == left) {
+            out[i] = 0;
+            continue;
+        }
+        ojr_binomial_init(&bp, left, 1.0 / (n - i));
+        out[i] = ojr_next_binomial(g, &bp);
+        left -= out[i];
+    }
+    out[n - 1] = left;
+}
+
+// Fill <out> with <n> indices from 0 to <n>-1 chosen with replacement.
+void ojr_bootstrap_indices(ojr_generator *g, int64_t n, int64_t *out) {
+    assert(0x5eed1e55 == g->init);
+    assert(n > 0);
+    indices(g, n, out);
+}
+
+// Fill <out> with the number of times each of <n> indices would be chosen.
+void ojr_bootstrap_counts(ojr_generator *g, int64_t n, int64_t *out) {
+    assert(0x5eed1e55 == g->init);
+    assert(n > 0);
+    counts(g, n, out);
+}
+
+/* Run <replicates> of <fn>, each writing <n> values to its own part of
+ * <out>, using up to <threads> threads or as many as OpenMP likes if
+ * <threads> is 0. If the generators for the threads can't be had, it all
+ * runs on <g> instead.
+ */
+static void replicate(ojr_generator *g, void (*fn)(ojr_generator *, int64_t,
+int64_t *), int64_t n, int64_t *out, int replicates, int threads) {
+    int i = 0, nt, id;
+    uint32_t *seeds;
+    ojr_generator **gens;
+
+    assert(0x5eed1e55 == g->init);
+    assert(n > 0 && replicates >= 0);
+    if (0 == replicates) return;
+#ifdef _OPENMP
+    nt = (threads > 0) ? threads : omp_get_max_threads();
+    if (nt > replicates) nt = replicates;
+#else
+    nt = 1;
+#endif
+    seeds = malloc((size_t)replicates * SEEDWORDS * sizeof(uint32_t));
+    gens = calloc(nt, sizeof(ojr_generator *));
+
+    if (NULL != gens) {
+        id = ojr_get_algorithm(g);
+        for (i = 0; i < nt; ++i) {
+            if (NULL == (gens[i] = ojr_open(ojr_algorithm_name(id)))) break;
+        }
+    }
+    if (NULL == seeds || NULL == gens || i < nt) {
+        for (i = 0; i < replicates; ++i) fn(g, n, out + (size_t)i * n);
+    } else {
+        for (i = 0; i < replicates * SEEDWORDS; ++i) seeds[i] = OJR_NEXT32(g);
+
+        PARALLEL_FOR
+        for (int r = 0; r < replicates; ++r) {
+            ojr_generator *rg = gens[THREADNUM()];
+
+            ojr_array_seed(rg, seeds + r * SEEDWORDS, SEEDWORDS);
+            fn(rg, n, out + (size_t)r * n);
+        }
+    }
+    if (NULL != gens) {
+        for (i = 0; i < nt && NULL != gens[i]; ++i) ojr_close(gens[i]);
+    }
+    free(gens);
+    free(seeds);
+}
+
+// <replicates> sets of indices, <n> apiece.
+void ojr_fill_bootstrap_indices(ojr_generator *g, int64_t n, int64_t *out,
+int replicates, int threads) {
+    replicate(g, indices, n, out, replicates, threads);
+}
+
+// <replicates> sets of counts, <n> apiece.
+void ojr_fill_bootstrap_counts(ojr_generator *g, int64_t n, int64_t *out,
+int replicates, int threads) {
+    replicate(g, counts, n, out, replicates, threads);
+}
@@ -152,12 +152,51 @@ uint64_t ojr_next64(ojr_generator *g) {
     return (r << 32) | OJR_NEXT32(g);
 }
 
+/* Fill <a> with the next <count> values, the same as that many calls. Words
+ * are copied straight out of the buffer a bufferful at a time.
+ */
+void ojr_fill32(ojr_generator *g, uint32_t *a, int count) {
+    int i, j, n;
+    assert(0x5eed1e55 == g->init && (g->flags & OJRF_SEEDED));
+
+    for (i = 0; i < count; i += n) {
+        if (g->bptr == g->buf) {
+            ojr_call_refill(g);
+            g->bptr = g->buf + g->bufsize;
+        }
+        n = g->bptr - g->buf;
+        if (n > count - i) n = count - i;
+
+        for (j = 0; j < n; ++j) a[i + j] = g->bptr[-1 - j];
+        g->bptr -= n;
+    }
+}
+
+void ojr_fill64(ojr_generator *g, uint64_t *a, int count) {
+    int i;
+    assert(0x5eed1e55 == g->init && (g->flags & OJRF_SEEDED));
+
+    for (i = 0; i < count; ++i) a[i] = OJR_NEXT64(g);
+}
+
 // Return double in range [0,1).
 double ojr_next_double(ojr_generator *g) {
     uint64_t r = (OJR_NEXT64(g) & 0xFFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
     return *(double *)(&r) - 1.0;
 }
 
+void ojr_fill_double(ojr_generator *g, double *a, int count) {
+    int i;
+    uint64_t r;
+    assert(0x5eed1e55 == g->init && (g->flags & OJRF_SEEDED));
+
+    for (i = 0; i < count; ++i) {
+        r = (OJR_NEXT64(g) & 0xFFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+        memcpy(a + i, &r, sizeof(double));
+        a[i] -= 1.0;
+    }
+}
+
 // Return double in range (-1,1).
 double ojr_next_signed_double(ojr_generator *g) {
     int sign;
@@ -209,6 +248,52 @@ int ojr_rand(ojr_generator *g, int limit) {
     return v;
 }
 
+/* Same for limits up to 2^32, by Lemire's multiply-and-shift, which needs a
+ * division only in the rare case that the product lands near a boundary.
+ */
+static inline uint32_t rand32(ojr_generator *g, uint32_t limit) {
+    uint64_t m;
+    uint32_t t;
+
+    m = (uint64_t)OJR_NEXT32(g) * limit;
+    if ((uint32_t)m < limit) {
+        t = -limit % limit;
+        while ((uint32_t)m < t) m = (uint64_t)OJR_NEXT32(g) * limit;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+uint32_t ojr_rand32(ojr_generator *g, uint32_t limit) {
+    assert(limit > 0);
+    return rand32(g, limit);
+}
+
+void ojr_fill_rand32(ojr_generator *g, uint32_t limit, uint32_t *a,
+int count) {
+    int i;
+    assert(limit > 0);
+    for (i = 0; i < count; ++i) a[i] = rand32(g, limit);
+}
+
+// And for 64-bit limits, by masking and rejection above 32 bits.
+uint64_t ojr_rand64(ojr_generator *g, uint64_t limit) {
+    uint64_t v, m = limit - 1;
+    assert(limit > 0);
+
+    if (limit <= 0xFFFFFFFF) return ojr_rand32(g, (uint32_t)limit);
+    m |= m >> 1;
+    m |= m >> 2;
+    m |= m >> 4;
+    m |= m >> 8;
+    m |= m >> 16;
+    m |= m >> 32;
+
+    do {
+        v = OJR_NEXT64(g) & m;
+    } while (v >= limit);
+    return v;
+}
+
 // Skip over <count> values of the generator without returning them.
 void ojr_discard(ojr_generator *g, int count) {
     int inbuf = g->bptr - g->buf;
@@ -234,16 +319,62 @@ void ojr_discard(ojr_generator *g, int count) {
     } while (count);
 }
 
-static int compare(const void *a, const void *b) {
-    return *(int*)a - *(int*)b;
+/* Fill given array with <count> random non-negative integers that add to
+ * <sum>: the gaps between count-1 uniform values from 0 to sum, sorted. The
+ * values are made in descending order as sorted uniforms, each the one
+ * above times V^(1/k) = exp(-E/k), so there's nothing to sort and it takes
+ * O(count) time. Doubles carry 53 bits, so for sums above 2^53 the gaps
+ * are only as fine as that.
+ */
+typedef struct _gaps {
+    double u, scale;
+    int64_t prev;
+} gaps;
+
+static inline void gapsinit(gaps *gp, int64_t sum) {
+    gp->u = 1.0;
+    gp->scale = (double)sum + 1.0;
+    gp->prev = sum;
+}
+
+// Gap above the k-th of the sorted values, k counting down to 1.
+static inline int64_t nextgap(ojr_generator *g, gaps *gp, int k) {
+    int64_t v, d;
+
+    gp->u *= exp(-ojr_next_exponential(g) / k);
+    v = (int64_t)(gp->u * gp->scale);
+    if (v > gp->prev) v = gp->prev;
+    d = gp->prev - v;
+    gp->prev = v;
+    return d;
 }
 
-// Fill given array with <count> random integers that add to <sum>.
-// Sort-and-diff method assures uniform distribution.
 void ojr_array_with_sum(ojr_generator *g, int *a, int count, int sum) {
     int i;
-    for (i = 0; i < count-1; ++i) { a[i] = ojr_rand(g, sum+1); }
-    qsort(a, count-1, sizeof(int), compare);
-    a[count-1] = sum;
-    for (i = count-1; i > 0; --i) { a[i] -= a[i-1]; }
+    gaps gs;
+    assert(count > 0 && sum >= 0);
+
+    gapsinit(&gs, sum);
+    for (i = count - 1; i > 0; --i) a[i] = (int)nextgap(g, &gs, i);
+    a[0] = (int)gs.prev;
+}
+
+void ojr_array_with_sum64(ojr_generator *g, int64_t *a, int count,
+int64_t sum) {
+    int i;
+    gaps gs;
+    assert(count > 0 && sum >= 0);
+
+    gapsinit(&gs, sum);
+    for (i = count - 1; i > 0; --i) a[i] = nextgap(g, &gs, i);
+    a[0] = gs.prev;
+}
+
+// <n> such arrays, one after another.
+void ojr_fill_array_with_sum64(ojr_generator *g, int64_t *a, int count,
+int64_t sum, int n) {
+    int i;
+    for (i = 0; i < n; ++i) {
+        ojr_array_with_sum64(g, a + (size_t)i * count, count, sum);
+    }
 }
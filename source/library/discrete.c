@@ -0,0 +1,338 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Discrete distributions: Poisson by inversion for small means and
+ * Hormann's PTRS transformed rejection for large ones, binomial by
+ * inversion or Hormann's BTRD, geometric from the exponential, negative
+ * binomial as a gamma mixture of Poissons, and multinomial as a chain of
+ * binomials, each category conditioned on the counts before it. Poisson
+ * and binomial constants are set up once in a caller-owned structure, so
+ * fixed-parameter fills don't recompute them.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "ojrandlib.h"
+
+/* Means at or above this use PTRS; binomials with n*min(p,1-p) at or above
+ * it use BTRD. Below, inversion is faster.
+ */
+#define RMIN 10.0
+
+
+void ojr_poisson_init(ojr_poisson *pp, double mean) {
+    double b;
+    assert(mean >= 0.0);
+
+    pp->mean = mean;
+    if (mean < RMIN) {
+        pp->ptrs = 0;
+        pp->emu = exp(-mean);
+        return;
+    }
+    pp->ptrs = 1;
+    pp->loglam = log(mean);
+    pp->b = b = 0.931 + 2.53 * sqrt(mean);
+    pp->a = -0.059 + 0.02483 * b;
+    pp->lia = log(1.1239 + 1.1328 / (b - 3.4));
+    pp->vr = 0.9277 - 3.6224 / (b - 2.0);
+}
+
+static inline int64_t poisson(ojr_generator *g, const ojr_poisson *pp) {
+    int64_t k;
+    double u, v, us, p, s;
+
+    if (! pp->ptrs) {
+        k = 0;
+        p = s = pp->emu;
+        u = ojr_next_double(g);
+        while (u > s && p > 0.0) {
+            ++k;
+            p *= pp->mean / k;
+            s += p;
+        }
+        return k;
+    }
+    while (1) {
+        u = ojr_next_double(g) - 0.5;
+        v = ojr_next_double(g);
+        us = 0.5 - fabs(u);
+        k = (int64_t)floor((2.0 * pp->a / us + pp->b) * u + pp->mean + 0.43);
+
+        if (us >= 0.07 && v <= pp->vr) return k;
+        if (k < 0 || (us < 0.013 && v > us)) continue;
+        if (log(v) + pp->lia - log(pp->a / (us * us) + pp->b) <=
+            -pp->mean + k * pp->loglam - lgamma(k + 1.0)) return k;
+    }
+}
+
+int64_t ojr_next_poisson(ojr_generator *g, ojr_poisson *pp) {
+    return poisson(g, pp);
+}
+
+void ojr_fill_poisson(ojr_generator *g, ojr_poisson *pp, int64_t *a,
+int count) {
+    int i;
+    for (i = 0; i < count; ++i) a[i] = poisson(g, pp);
+}
+
+// Stirling series correction, log(k!) - log of Stirling's approximation.
+
+static double fctable[10] = {
+    0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+    0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+    0.01189670994589177, 0.01041126526197209, 0.009255462182712733,
+    0.008330563433362871
+};
+
+static inline double fc(int64_t k) {
+    double r;
+
+    if (k < 10) return fctable[k];
+    r = 1.0 / (k + 1.0);
+    r *= r;
+    return (1.0 / 12.0 - (1.0 / 360.0 - r / 1260.0) * r) / (k + 1.0);
+}
+
+void ojr_binomial_init(ojr_binomial *bp, int64_t n, double p) {
+    double q, npq, sq;
+    assert(n >= 0 && p >= 0.0 && p <= 1.0);
+
+    bp->n = n;
+    bp->flip = (p > 0.5);
+    if (bp->flip) p = 1.0 - p;
+    bp->p = p;
+    q = 1.0 - p;
+    bp->r = p / q;
+    bp->nr = (n + 1) * bp->r;
+
+    if (n * p < RMIN) {
+        bp->btrd = 0;
+        bp->qn = exp(n * log1p(-p));
+        return;
+    }
+    bp->btrd = 1;
+    bp->m = (int64_t)floor((n + 1) * p);
+    bp->npq = npq = n * p * q;
+    sq = sqrt(npq);
+    bp->b = 1.15 + 2.53 * sq;
+    bp->a = -0.0873 + 0.0248 * bp->b + 0.01 * p;
+    bp->c = n * p + 0.5;
+    bp->alpha = (2.83 + 5.1 / bp->b) * sq;
+    bp->vr = 0.92 - 4.2 / bp->b;
+    bp->urvr = 0.86 * bp->vr;
+    bp->h = (bp->m + 0.5) * log((bp->m + 1.0) / (bp->r * (n - bp->m + 1.0)))
+        + fc(bp->m) + fc(n - bp->m);
+}
+
+static inline int64_t inversion(ojr_generator *g, const ojr_binomial *bp) {
+    int64_t k;
+    double u, r;
+
+    while (1) {
+        k = 0;
+        r = bp->qn;
+        u = ojr_next_double(g);
+        while (u > r) {
+            u -= r;
+            if (++k > bp->n || r <= 0.0) break;
+            r *= bp->nr / k - bp->r;
+        }
+        if (k <= bp->n && u <= r) return k;
+    }
+}
+
+static inline int64_t btrd(ojr_generator *g, const ojr_binomial *bp) {
+    int64_t i, k, km, nk;
+    double u, v, us, f, rho, t;
+
+    while (1) {
+        v = ojr_next_double(g);
+        if (v <= bp->urvr) {
+            u = v / bp->vr - 0.43;
+            return (int64_t)floor((2.0 * bp->a / (0.5 - fabs(u)) + bp->b) * u
+                + bp->c);
+        }
+        if (v >= bp->vr) {
+            u = ojr_next_double(g) - 0.5;
+        } else {
+            u = v / bp->vr - 0.93;
+            u = ((u < 0.0) ? -0.5 : 0.5) - u;
+            v = ojr_next_double(g) * bp->vr;
+        }
+        us = 0.5 - fabs(u);
+        k = (int64_t)floor((2.0 * bp->a / us + bp->b) * u + bp->c);
+        if (k < 0 || k > bp->n) continue;
+
+        v = v * bp->alpha / (bp->a / (us * us) + bp->b);
+        km = (k > bp->m) ? k - bp->m : bp->m - k;
+
+        if (km <= 15) {
+            // Recursive evaluation of f(k)/f(m)
+            f = 1.0;
+            if (bp->m < k) {
+                for (i = bp->m + 1; i <= k; ++i) f *= bp->nr / i - bp->r;
+            } else if (bp->m > k) {
+                for (i = k + 1; i <= bp->m; ++i) v *= bp->nr / i - bp->r;
+            }
+            if (v <= f) return k;
+            continue;
+        }
+        // Squeeze, then the full test with Stirling corrections
+        v = log(v);
+        rho = (km / bp->npq) *
+            (((km / 3.0 + 0.625) * km + 1.0 / 6.0) / bp->npq + 0.5);
+        t = -(double)km * km / (2.0 * bp->npq);
+        if (v < t - rho) return k;
+        if (v > t + rho) continue;
+
+        nk = bp->n - k + 1;
+        if (v <= bp->h + (bp->n + 1.0) * log((bp->n - bp->m + 1.0) / nk) +
+            (k + 0.5) * log(nk * bp->r / (k + 1.0)) -
+            fc(k) - fc(bp->n - k)) return k;
+    }
+}
+
+static inline int64_t binomial(ojr_generator *g, const ojr_binomial *bp) {
+    int64_t k = bp->btrd ? btrd(g, bp) : inversion(g, bp);
+    return bp->flip ? bp->n - k : k;
+}
+
+int64_t ojr_next_binomial(ojr_generator *g, ojr_binomial *bp) {
+    return binomial(g, bp);
+}
+
+void ojr_fill_binomial(ojr_generator *g, ojr_binomial *bp, int64_t *a,
+int count) {
+    int i;
+    for (i = 0; i < count; ++i) a[i] = binomial(g, bp);
+}
+
+/* Geometric is the number of failures before the first success with
+ * probability <p>, which is floor(E / -log(1-p)).
+ */
+
+int64_t ojr_next_geometric(ojr_generator *g, double p) {
+    assert(p > 0.0 && p <= 1.0);
+    if (1.0 == p) return 0;
+    return (int64_t)floor(ojr_next_exponential(g) / -log1p(-p));
+}
+
+void ojr_fill_geometric(ojr_generator *g, double p, int64_t *a, int count) {
+    int i;
+    double s;
+    assert(p > 0.0 && p <= 1.0);
+
+    if (1.0 == p) {
+        for (i = 0; i < count; ++i) a[i] = 0;
+        return;
+    }
+    s = -1.0 / log1p(-p);
+    for (i = 0; i < count; ++i) {
+        a[i] = (int64_t)floor(ojr_next_exponential(g) * s);
+    }
+}
+
+/* Negative binomial, the number of failures before <r> successes with
+ * probability <p>, is Poisson with a gamma(r, (1-p)/p) distributed mean.
+ */
+
+int64_t ojr_next_negative_binomial(ojr_generator *g, double r, double p) {
+    ojr_poisson pp;
+    assert(r > 0.0 && p > 0.0 && p <= 1.0);
+
+    if (1.0 == p) return 0;
+    ojr_poisson_init(&pp, ojr_next_gamma(g, r, (1.0 - p) / p));
+    return poisson(g, &pp);
+}
+
+void ojr_fill_negative_binomial(ojr_generator *g, double r, double p,
+int64_t *a, int count) {
+    int i, j, n;
+    double m[64];
+    ojr_poisson pp;
+    assert(r > 0.0 && p > 0.0 && p <= 1.0);
+
+    for (i = 0; i < count; i += n) {
+        n = count - i;
+        if (n > 64) n = 64;
+        if (1.0 == p) {
+            for (j = 0; j < n; ++j) a[i + j] = 0;
+            continue;
+        }
+        ojr_fill_gamma(g, r, (1.0 - p) / p, m, n);
+        for (j = 0; j < n; ++j) {
+            ojr_poisson_init(&pp, m[j]);
+            a[i + j] = poisson(g, &pp);
+        }
+    }
+}
+
+/* Split <n> trials among <k> categories with probabilities proportional to
+ * <p>. Each count is binomial on the trials left over, with its share of
+ * the weight left over, and the last category of positive weight takes
+ * whatever remains, so rounding can't leave any to one of zero weight.
+ * If no weight is positive (which asserts catch in debug builds), every
+ * count is zero.
+ */
+static void multinomial(ojr_generator *g, int64_t n, const double *p, int k,
+double total, int64_t *out) {
+    int i, last;
+    double q;
+    ojr_binomial bp;
+
+    if (! (total > 0.0)) {
+        for (i = 0; i < k; ++i) out[i] = 0;
+        return;
+    }
+    for (last = k - 1; last > 0 && ! (p[last] > 0.0); --last) out[last] = 0;
+    for (i = 0; i < last; ++i) {
+        if (0 == n || ! (p[i] > 0.0)) {
+            out[i] = 0;
+            continue;
+        }
+        q = (total > p[i]) ? p[i] / total : 1.0;
+        ojr_binomial_init(&bp, n, q);
+        out[i] = binomial(g, &bp);
+        n -= out[i];
+        total -= p[i];
+    }
+    out[last] = n;
+}
+
+static double weightsum(const double *p, int k) {
+    int i;
+    double total = 0.0;
+
+    for (i = 0; i < k; ++i) {
+        assert(p[i] >= 0.0);
+        total += p[i];
+    }
+    assert(total > 0.0);
+    return total;
+}
+
+void ojr_next_multinomial(ojr_generator *g, int64_t n, double *p, int k,
+int64_t *out) {
+    assert(n >= 0 && k > 0);
+    multinomial(g, n, p, k, weightsum(p, k), out);
+}
+
+void ojr_fill_multinomial(ojr_generator *g, int64_t n, double *p, int k,
+int64_t *out, int count) {
+    int i;
+    double total;
+
+    assert(n >= 0 && k > 0);
+    total = weightsum(p, k);
+    for (i = 0; i < count; ++i) {
+        multinomial(g, n, p, k, total, out + (size_t)i * k);
+    }
+}
@@ -0,0 +1,215 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Gamma distribution by Marsaglia and Tsang's method on top of the ziggurat
+ * normal, and the distributions derived from it: beta, chi-square, Student's
+ * t, and Dirichlet. The fill functions set up their constants once, but draw
+ * the same values as repeated calls to the single-value functions.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "ojrandlib.h"
+
+/* Constants for a given shape. Shapes below 1 are sampled as shape + 1 and
+ * scaled by U^(1/shape) = exp(-E/shape). That underflows to 0 for small
+ * shapes, so beta and Dirichlet, which divide by a sum of gammas, keep such
+ * samples as logs.
+ */
+typedef struct _gparams {
+    double d, c, ia;
+    int small;
+} gparams;
+
+static void gsetup(gparams *p, double a) {
+    assert(a > 0.0);
+    p->small = (a < 1.0);
+    if (p->small) {
+        p->ia = 1.0 / a;
+        a += 1.0;
+    }
+    p->d = a - 1.0 / 3.0;
+    p->c = 1.0 / sqrt(9.0 * p->d);
+}
+
+// Gamma(shape) for shapes >= 1, or gamma(shape + 1) for those below.
+
+static inline double gcore(ojr_generator *g, const gparams *p) {
+    double x, v, u;
+
+    while (1) {
+        do {
+            x = ojr_next_normal(g);
+            v = 1.0 + p->c * x;
+        } while (v <= 0.0);
+
+        v = v * v * v;
+        u = ojr_next_double(g);
+        x *= x;
+        if (u < 1.0 - 0.0331 * x * x) break;
+        if (log(u) < 0.5 * x + p->d * (1.0 - v + log(v))) break;
+    }
+    return p->d * v;
+}
+
+static inline double gsample(ojr_generator *g, const gparams *p) {
+    double x = gcore(g, p);
+
+    if (p->small) return x * exp(-ojr_next_exponential(g) * p->ia);
+    return x;
+}
+
+// Log of the same sample, which doesn't underflow.
+
+static inline double glogsample(ojr_generator *g, const gparams *p) {
+    double x = log(gcore(g, p));
+
+    if (p->small) return x - ojr_next_exponential(g) * p->ia;
+    return x;
+}
+
+double ojr_next_gamma(ojr_generator *g, double shape, double scale) {
+    gparams p;
+
+    gsetup(&p, shape);
+    return scale * gsample(g, &p);
+}
+
+void ojr_fill_gamma(ojr_generator *g, double shape, double scale,
+double *a, int count) {
+    int i;
+    gparams p;
+
+    gsetup(&p, shape);
+    for (i = 0; i < count; ++i) a[i] = scale * gsample(g, &p);
+}
+
+// Chi-square with <k> degrees of freedom is gamma(k/2, 2).
+
+double ojr_next_chisquare(ojr_generator *g, double k) {
+    return ojr_next_gamma(g, 0.5 * k, 2.0);
+}
+
+void ojr_fill_chisquare(ojr_generator *g, double k, double *a, int count) {
+    ojr_fill_gamma(g, 0.5 * k, 2.0, a, count);
+}
+
+/* Beta is X/(X+Y) for X, Y gammas with the two shapes. If either is small,
+ * that's 1/(1 + exp(log Y - log X)).
+ */
+
+static inline double bsample(ojr_generator *g, const gparams *pa,
+const gparams *pb) {
+    double x, y;
+
+    if (pa->small || pb->small) {
+        x = glogsample(g, pa);
+        y = glogsample(g, pb);
+        return 1.0 / (1.0 + exp(y - x));
+    }
+    x = gsample(g, pa);
+    y = gsample(g, pb);
+    return x / (x + y);
+}
+
+double ojr_next_beta(ojr_generator *g, double alpha, double beta) {
+    gparams pa, pb;
+
+    gsetup(&pa, alpha);
+    gsetup(&pb, beta);
+    return bsample(g, &pa, &pb);
+}
+
+void ojr_fill_beta(ojr_generator *g, double alpha, double beta,
+double *a, int count) {
+    int i;
+    gparams pa, pb;
+
+    gsetup(&pa, alpha);
+    gsetup(&pb, beta);
+    for (i = 0; i < count; ++i) a[i] = bsample(g, &pa, &pb);
+}
+
+// Student's t with <nu> degrees of freedom is Z / sqrt(V/nu), V chi-square.
+
+double ojr_next_student_t(ojr_generator *g, double nu) {
+    gparams p;
+    double z;
+
+    gsetup(&p, 0.5 * nu);
+    z = ojr_next_normal(g);
+    return z / sqrt(2.0 * gsample(g, &p) / nu);
+}
+
+void ojr_fill_student_t(ojr_generator *g, double nu, double *a, int count) {
+    int i;
+    gparams p;
+    double z;
+
+    gsetup(&p, 0.5 * nu);
+    for (i = 0; i < count; ++i) {
+        z = ojr_next_normal(g);
+        a[i] = z / sqrt(2.0 * gsample(g, &p) / nu);
+    }
+}
+
+/* Dirichlet with <k> parameters <alpha>, written to <out>, is a vector of
+ * gammas normalized to sum to 1. The fill version writes <count> such
+ * vectors consecutively. Constants for the gammas are set up once in <p>,
+ * or if there's no table, for each one as it's needed, which gives the same
+ * values. With any small shape, the gammas are kept as logs and scaled by
+ * the largest before normalizing.
+ */
+
+static inline void dsample(ojr_generator *g, const double *alpha,
+const gparams *p, int k, double *out) {
+    int i, small = 0;
+    double m, sum = 0.0;
+    gparams one;
+
+    for (i = 0; i < k; ++i) {
+        if (alpha[i] < 1.0) small = 1;
+    }
+    for (i = 0; i < k; ++i) {
+        if (NULL == p) gsetup(&one, alpha[i]);
+        out[i] = small ? glogsample(g, p ? p + i : &one) :
+            gsample(g, p ? p + i : &one);
+    }
+    if (small) {
+        m = out[0];
+        for (i = 1; i < k; ++i) if (out[i] > m) m = out[i];
+        for (i = 0; i < k; ++i) out[i] = exp(out[i] - m);
+    }
+    for (i = 0; i < k; ++i) sum += out[i];
+    sum = 1.0 / sum;
+    for (i = 0; i < k; ++i) out[i] *= sum;
+}
+
+void ojr_next_dirichlet(ojr_generator *g, double *alpha, int k, double *out) {
+    assert(k > 0);
+    dsample(g, alpha, NULL, k, out);
+}
+
+void ojr_fill_dirichlet(ojr_generator *g, double *alpha, int k,
+double *out, int count) {
+    int i;
+    gparams *p;
+
+    assert(k > 0);
+    p = malloc(k * sizeof(gparams));
+    if (NULL != p) {
+        for (i = 0; i < k; ++i) gsetup(p + i, alpha[i]);
+    }
+
+    for (i = 0; i < count; ++i) {
+        dsample(g, alpha, p, k, out + (size_t)i * k);
+    }
+    free(p);
+}
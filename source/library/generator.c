@@ -176,38 +176,18 @@ void ojr_default_seed(ojr_generator *g, uint32_t *seed, int size) {
 }
 
 
-#define SWAP(a,b) do { if ((a) != (b)) { \
-t = array[a]; array[a] = array[b]; array[b] = t; \
-} } while(0)
-
 /* Move to the top of the array a randomly-chosen combination of <count>
  * elements, where each combination and permutation is equally likely.
- * If <count> == <size>, this becomes a standard Fisher-Yates shuffle.
+ * If <count> == <size>, this becomes a standard Fisher-Yates shuffle. See
+ * ojr_shuffle() in shuffle.c.
  */
 
 void ojr_shuffle_int_array(
 ojr_generator *g, int *array, int size, int count) {
-    int i, r, t;
-
-    if (size < 2) return;
-    if (count == size) --count;
-
-    for (i = 0; i < count; ++i) {
-        r = ojr_rand(g, size - i);
-        SWAP(i, i + r);
-    }
+    ojr_shuffle(g, array, size, sizeof(int), count);
 }
 
 void ojr_shuffle_pointer_array(
 ojr_generator *g, void **array, int size, int count) {
-    int i, r;
-    void *t;
-
-    if (size < 2) return;
-    if (count == size) --count;
-
-    for (i = 0; i < count; ++i) {
-        r = ojr_rand(g, size - i);
-        SWAP(i, i + r);
-    }
+    ojr_shuffle(g, array, size, sizeof(void *), count);
 }
@@ -65,6 +65,7 @@ int ojr_library_shutdown(void) {
         fprintf(stderr, "ojrandlib: %d generator object%s not freed.\n",
             c, (c > 1) ? "s" : "");
     }
+    ojr_zigtable_release_all();
     return 0;
 }
 
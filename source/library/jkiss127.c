@@ -30,19 +30,27 @@ static void _ojr_jkiss127_reseed(ojr_generator *g, uint32_t *seed, int size) {
 static void _ojr_jkiss127_refill(ojr_generator *g) {
     int i;
     uint32_t *s = g->state, *bp = g->buf + g->bufsize;
+    uint32_t a = s[0], b = s[1], c = s[2], d = s[3];
     uint64_t t;
     assert(4 == g->statesize);
 
+    /* State is kept in locals, since the buffer might alias it as far as
+     * the compiler knows, and would be reloaded every time round.
+     */
     for (i = 0; i < g->bufsize; ++i) {
-        s[0] = 314527869 * s[0] + 1234567;
-        s[1] ^= s[1] << 5;
-        s[1] ^= s[1] >> 7;
-        s[1] ^= s[1] << 22;
-        t = 4294584393ULL * s[2] + s[3];
-        s[3] = t >> 32;
-        s[2] = t;
-        *--bp = s[0] + s[1] + s[2];
+        a = 314527869 * a + 1234567;
+        b ^= b << 5;
+        b ^= b >> 7;
+        b ^= b << 22;
+        t = 4294584393ULL * c + d;
+        d = t >> 32;
+        c = t;
+        *--bp = a + b + c;
     }
+    s[0] = a;
+    s[1] = b;
+    s[2] = c;
+    s[3] = d;
 }
 
 /* Every algorithm must define this structure publically, and add its address
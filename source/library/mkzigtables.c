@@ -0,0 +1,94 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Build-time tool that writes zigtables.h to stdout. Usage:
+ *
+ *     mkzigtables [normal-layers [exponential-layers]]
+ *
+ * Layer counts are powers of 2 from 8 to 4096, defaulting to the 128 and
+ * 256 from GM's paper. More layers means a larger table but a fast-path
+ * acceptance rate closer to 100%.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+static void dtable(const char *name, double *t, int n) {
+    int i;
+
+    printf("static double %s[] = {", name);
+    for (i = 0; i < n; ++i) {
+        printf("%s%.20g", (i % 3) ? ", " : (i ? ",\n    " : "\n    "), t[i]);
+    }
+    printf("\n};\n\n");
+}
+
+static void itable(const char *name, uint64_t *t, int n) {
+    int i;
+
+    printf("static uint64_t %s[] = {", name);
+    for (i = 0; i < n; ++i) {
+        printf("%s0x%llx", (i % 4) ? ", " : (i ? ",\n    " : "\n    "),
+            (unsigned long long)t[i]);
+    }
+    printf("\n};\n\n");
+}
+
+static void tables(ojr_zigtable *zt, char p, const char *desc) {
+    char name[8];
+
+    printf("#define Z%cLAYERS %d\n", p - 32, zt->layers);
+    printf("#define Z%cSHIFT %d\n", p - 32, zt->shift);
+    printf("#define Z%cR %.20g\n", p - 32, zt->r);
+    printf("#define Z%cV %.20g\n\n", p - 32, zt->v);
+
+    printf("/* x values for %s\n */\n", desc);
+    sprintf(name, "z%cx", p);
+    dtable(name, zt->x, zt->layers + 1);
+
+    printf("/* Density at each x for %s, used by the wedge test\n */\n", desc);
+    sprintf(name, "z%cf", p);
+    dtable(name, zt->f, zt->layers + 1);
+
+    printf("/* Pre-computed ratios for %s\n */\n\n", desc);
+    printf("#ifdef INTEGER_COMPARE\n\n");
+    sprintf(name, "z%cri", p);
+    itable(name, zt->ri, zt->layers);
+    printf("#else /* INTEGER_COMPARE */\n\n");
+    sprintf(name, "z%cr", p);
+    dtable(name, zt->rd, zt->layers);
+    printf("#endif /* INTEGER_COMPARE */\n\n");
+}
+
+int main(int argc, char *argv[]) {
+    int nl = 128, el = 256;
+    ojr_zigtable *zn, *ze;
+
+    if (argc > 1) nl = atoi(argv[1]);
+    if (argc > 2) el = atoi(argv[2]);
+
+    zn = ojr_zigtable_normal(nl);
+    ze = ojr_zigtable_exponential(el);
+    if (NULL == zn || NULL == ze) {
+        fprintf(stderr, "mkzigtables: layer counts must be powers of 2 "
+            "from 8 to 4096.\n");
+        return EXIT_FAILURE;
+    }
+    printf("/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>\n"
+        " *\n * Lookup tables for ziggurat.c, generated by mkzigtables with\n"
+        " * %d normal and %d exponential layers. Do not edit.\n */\n\n", nl, el);
+
+    tables(ze, 'e', "exponential");
+    tables(zn, 'n', "normal");
+
+    ojr_zigtable_free(zn);
+    ojr_zigtable_free(ze);
+    return EXIT_SUCCESS;
+}
@@ -12,11 +12,27 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 
 /* STRUCTURES */
 
+/* Ziggurat tables for a monotone decreasing density on [0, inf), built by
+ * zigbuild.c. x[] and f[] have layers + 1 entries: x[0] is the pseudo-width
+ * of the base layer, x[1] is the start of the tail, and x[layers] is 0.
+ */
+struct _ojr_zigtable {
+    int layers;     // Number of layers, a power of 2
+    int shift;      // log2(layers)
+    double r;       // Start of tail
+    double v;       // Area of each layer
+    uint64_t *ri;   // x[i+1]/x[i] as 52-bit mantissa for integer compare
+    double *rd;     // x[i+1]/x[i] as double
+    double *x;      // Layer edges, decreasing
+    double *f;      // Density at each x, so the wedge test needs only f(x)
+};
+
 /* Main working generator object
  */
 struct _ojr_generator {
@@ -32,12 +48,25 @@ struct _ojr_generator {
                         // bptr = buf means empty buffer
     struct _ojr_generator *next;    // For list of allocated generators
     void *extra;        // For miscellaneous client use
-    void *padding[4];   // Guarding against ABI change
+    struct _ojr_zigtable *znormal;  // Ziggurat tables if not the default
+    struct _ojr_zigtable *zexp;
+    void *padding[2];   // Guarding against ABI change
 };
 
 // Flags
 #define OJRF_SEEDED 0x01
 
+/* User-defined ziggurat for sampling from other monotone densities, or
+ * symmetric ones using a sign bit. See ojr_ziggurat_new() in ziggurat.c.
+ */
+struct _ojr_ziggurat {
+    struct _ojr_zigtable *table;
+    double (*density)(double, void *);
+    double (*tail)(struct _ojr_generator *, double, void *);
+    void *arg;          // Passed to the above
+    int symmetric;
+};
+
 /* Algorithm description. Should be immutable.
  */
 struct _ojr_algorithm {
@@ -57,8 +86,94 @@ struct _ojr_algorithm {
     void *padding[4];
 };
 
+/* Precomputed constants for Poisson and binomial distributions, filled in
+ * by ojr_poisson_init() and ojr_binomial_init() in discrete.c.
+ */
+struct _ojr_poisson {
+    double mean;
+    int ptrs;           // Nonzero for transformed rejection
+    double emu;         // exp(-mean), for inversion
+    double loglam, a, b, lia, vr;
+};
+
+struct _ojr_binomial {
+    int64_t n, m;
+    double p;           // min(p, 1-p)
+    int flip;           // Nonzero if p > 0.5, so we return n - k
+    int btrd;           // Nonzero for transformed rejection
+    double r, nr, qn;   // p/q, (n+1)p/q, and q^n for inversion
+    double npq, a, b, c, alpha, vr, urvr, h;
+};
+
+/* Alias table for weighted choice, built by ojr_alias_new() in alias.c.
+ */
+struct _ojr_alias_entry {
+    uint32_t threshold; // Keep column if high 32 bits are below this
+    uint32_t alias;     // Otherwise use this one
+};
+
+struct _ojr_alias {
+    int count;          // Number of categories
+    int size;           // Columns, padded to a power of 2
+    int shift;          // log2(size)
+    struct _ojr_alias_entry *table;
+};
+
+/* Sum tree for weighted choice with changing weights, see sumtree.c.
+ */
+struct _ojr_sumtree {
+    int count;          // Number of items
+    int height;         // Levels below the root
+    int64_t first;      // Node number of item 0
+    int64_t size;       // Allocated nodes
+    double total;       // Sum of all weights
+    double *v;          // Node sums, 64-byte aligned
+    void *mem;          // Allocated block containing v
+};
+
+/* Reservoir for sampling from a stream, see reservoir.c.
+ */
+struct _ojr_reservoir {
+    int k;              // Reservoir size
+    int weighted;       // Use weighted offers
+    int filled;         // Slots holding an item (weighted)
+    int64_t seen;       // Items offered or skipped so far
+    int64_t next;       // Index of next item to take (unweighted)
+    double w;           // Algorithm L's W (unweighted)
+    double jump;        // Weight left to skip (weighted)
+    double *keys;       // Min-heap of log keys (weighted)
+    int *slots;         // Slot of each heap entry (weighted)
+};
+
+/* Shuffles draw their swap targets this many at a time, both ojr_shuffle()
+ * and the C++ Generator::shuffle(), which must agree to give the same
+ * permutation.
+ */
+#define OJR_SHUFFLE_BATCH 16
+
+/* Computed random permutation of [0, n), see permutation.c.
+ */
+#define OJR_PERM_ROUNDS 8
+#define OJR_PERM_SMALL 256
+
+struct _ojr_permutation {
+    int64_t n;          // Size of domain
+    int hbits, lbits;   // Bits in high and low halves, differing by 0 or 1
+    uint32_t keys[2 * OJR_PERM_ROUNDS];
+    uint8_t small[OJR_PERM_SMALL];  // Whole permutation, if n fits
+};
+
 typedef struct _ojr_algorithm ojr_algorithm;
 typedef struct _ojr_generator ojr_generator;
+typedef struct _ojr_zigtable ojr_zigtable;
+typedef struct _ojr_ziggurat ojr_ziggurat;
+typedef struct _ojr_poisson ojr_poisson;
+typedef struct _ojr_binomial ojr_binomial;
+typedef struct _ojr_alias_entry ojr_alias_entry;
+typedef struct _ojr_alias ojr_alias;
+typedef struct _ojr_sumtree ojr_sumtree;
+typedef struct _ojr_reservoir ojr_reservoir;
+typedef struct _ojr_permutation ojr_permutation;
 
 
 /* GLOBALS */
@@ -100,18 +215,112 @@ extern char *ojr_algorithm_name(int);
 extern uint16_t ojr_next16(ojr_generator *);
 extern uint32_t ojr_next32(ojr_generator *);
 extern uint64_t ojr_next64(ojr_generator *);
+extern void ojr_fill32(ojr_generator *, uint32_t *, int);
+extern void ojr_fill64(ojr_generator *, uint64_t *, int);
 extern double ojr_next_double(ojr_generator *);
+extern void ojr_fill_double(ojr_generator *, double *, int);
 extern double ojr_next_signed_double(ojr_generator *);
 
 extern double ojr_next_exponential(ojr_generator *);
 extern double ojr_next_normal(ojr_generator *);
+extern void ojr_fill_exponential(ojr_generator *, double *, int);
+extern void ojr_fill_normal(ojr_generator *, double *, int);
+
+extern ojr_ziggurat *ojr_ziggurat_new(int, int, double (*)(double, void *),
+    double (*)(double, void *), double (*)(double, void *),
+    double (*)(ojr_generator *, double, void *), void *);
+extern void ojr_ziggurat_free(ojr_ziggurat *);
+extern double ojr_next_ziggurat(ojr_generator *, ojr_ziggurat *);
+extern void ojr_fill_ziggurat(ojr_generator *, ojr_ziggurat *, double *, int);
+
+extern double ojr_next_gamma(ojr_generator *, double, double);
+extern void ojr_fill_gamma(ojr_generator *, double, double, double *, int);
+extern double ojr_next_chisquare(ojr_generator *, double);
+extern void ojr_fill_chisquare(ojr_generator *, double, double *, int);
+extern double ojr_next_beta(ojr_generator *, double, double);
+extern void ojr_fill_beta(ojr_generator *, double, double, double *, int);
+extern double ojr_next_student_t(ojr_generator *, double);
+extern void ojr_fill_student_t(ojr_generator *, double, double *, int);
+extern void ojr_next_dirichlet(ojr_generator *, double *, int, double *);
+extern void ojr_fill_dirichlet(ojr_generator *, double *, int, double *, int);
+
+extern void ojr_poisson_init(ojr_poisson *, double);
+extern int64_t ojr_next_poisson(ojr_generator *, ojr_poisson *);
+extern void ojr_fill_poisson(ojr_generator *, ojr_poisson *, int64_t *, int);
+extern void ojr_binomial_init(ojr_binomial *, int64_t, double);
+extern int64_t ojr_next_binomial(ojr_generator *, ojr_binomial *);
+extern void ojr_fill_binomial(ojr_generator *, ojr_binomial *, int64_t *, int);
+extern int64_t ojr_next_geometric(ojr_generator *, double);
+extern void ojr_fill_geometric(ojr_generator *, double, int64_t *, int);
+extern int64_t ojr_next_negative_binomial(ojr_generator *, double, double);
+extern void ojr_fill_negative_binomial(ojr_generator *, double, double,
+    int64_t *, int);
+extern void ojr_next_multinomial(ojr_generator *, int64_t, double *, int,
+    int64_t *);
+extern void ojr_fill_multinomial(ojr_generator *, int64_t, double *, int,
+    int64_t *, int);
+
+extern int ojr_set_normal_layers(ojr_generator *, int);
+extern int ojr_get_normal_layers(ojr_generator *);
+extern int ojr_set_exponential_layers(ojr_generator *, int);
+extern int ojr_get_exponential_layers(ojr_generator *);
 
 extern int ojr_rand(ojr_generator *, int);
+extern uint32_t ojr_rand32(ojr_generator *, uint32_t);
+extern void ojr_fill_rand32(ojr_generator *, uint32_t, uint32_t *, int);
+extern uint64_t ojr_rand64(ojr_generator *, uint64_t);
 extern void ojr_discard(ojr_generator *, int);
 extern void ojr_array_with_sum(ojr_generator *, int *, int, int);
+extern void ojr_array_with_sum64(ojr_generator *, int64_t *, int, int64_t);
+extern void ojr_fill_array_with_sum64(ojr_generator *, int64_t *, int, int64_t,
+    int);
+
+extern ojr_alias *ojr_alias_new(double *, int);
+extern void ojr_alias_free(ojr_alias *);
+extern int ojr_next_alias(ojr_generator *, ojr_alias *);
+extern void ojr_fill_alias(ojr_generator *, ojr_alias *, int *, int);
+
+extern ojr_sumtree *ojr_sumtree_new(double *, int);
+extern void ojr_sumtree_free(ojr_sumtree *);
+extern void ojr_sumtree_update(ojr_sumtree *, int, double);
+extern double ojr_sumtree_weight(ojr_sumtree *, int);
+extern double ojr_sumtree_total(ojr_sumtree *);
+extern int ojr_next_sumtree(ojr_generator *, ojr_sumtree *);
+extern void ojr_fill_sumtree(ojr_generator *, ojr_sumtree *, int *, int);
+
+extern ojr_reservoir *ojr_reservoir_new(int, int);
+extern void ojr_reservoir_free(ojr_reservoir *);
+extern int ojr_reservoir_offer(ojr_generator *, ojr_reservoir *);
+extern int ojr_reservoir_offer_weighted(ojr_generator *, ojr_reservoir *,
+    double);
+extern int64_t ojr_reservoir_skip(ojr_reservoir *);
 
 extern void ojr_shuffle_int_array(ojr_generator *, int *, int, int);
 extern void ojr_shuffle_pointer_array(ojr_generator *, void **, int, int);
+extern void ojr_shuffle(ojr_generator *, void *, int64_t, size_t, int64_t);
+extern void ojr_shuffle_targets(ojr_generator *, int64_t, int64_t, int64_t *,
+    int);
+extern void ojr_deal(ojr_generator *, int, const int *, int, uint64_t *);
+extern void ojr_fill_deal(ojr_generator *, int, const int *, int, uint64_t *,
+    int);
+extern void ojr_parallel_shuffle(ojr_generator *, void *, int64_t, size_t,
+    int);
+
+extern void ojr_bootstrap_indices(ojr_generator *, int64_t, int64_t *);
+extern void ojr_bootstrap_counts(ojr_generator *, int64_t, int64_t *);
+extern void ojr_fill_bootstrap_indices(ojr_generator *, int64_t, int64_t *,
+    int, int);
+extern void ojr_fill_bootstrap_counts(ojr_generator *, int64_t, int64_t *,
+    int, int);
+
+extern ojr_permutation *ojr_permutation_new(ojr_generator *, int64_t);
+extern void ojr_permutation_free(ojr_permutation *);
+extern int64_t ojr_permutation_at(ojr_permutation *, int64_t);
+extern void ojr_permutation_range(ojr_permutation *, int64_t, int64_t *, int);
+
+extern void ojr_sample_indices(ojr_generator *, int64_t, int64_t, int64_t *);
+extern void ojr_sample_indices_unsorted(ojr_generator *, int64_t, int64_t,
+    int64_t *);
 
 /* Internal structure access, mostly for use by language bindings.
  */
@@ -150,6 +359,13 @@ extern void ojr_call_refill(ojr_generator *);
 extern void ojr_default_reseed(ojr_generator *, uint32_t *, int);
 extern void ojr_default_seed(ojr_generator *, uint32_t *, int);
 
+extern ojr_zigtable *ojr_zigtable_new(int, double (*)(double, void *),
+    double (*)(double, void *), double (*)(double, void *), void *);
+extern ojr_zigtable *ojr_zigtable_normal(int);
+extern ojr_zigtable *ojr_zigtable_exponential(int);
+extern void ojr_zigtable_free(ojr_zigtable *);
+extern void ojr_zigtable_release_all(void);
+
 
 #ifdef __cplusplus
 } /* end of extern "C" */
@@ -172,6 +388,26 @@ ojr_call_refill(g), (g)->bptr = (g)->buf + (g)->bufsize \
 
 #ifdef __cplusplus
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <stdexcept>
+#if __cplusplus >= 202002L
+#  include <span>
+#  include <ranges>
+#endif
+
+#if __cplusplus >= 201103L
+#  define OJR_CONSTEXPR constexpr
+#else
+#  define OJR_CONSTEXPR
+#endif
+#if __cplusplus >= 201402L
+#  define OJR_CONSTEXPR14 constexpr
+#else
+#  define OJR_CONSTEXPR14 inline
+#endif
+
 namespace oj {
 
 typedef std::vector<uint32_t> Seed;
@@ -191,20 +427,75 @@ double nextExponential(void);
 int rand(int);
 
 
+class Alias;
+class Generator64;
+class Normal;
+class Exponential;
+class Poisson;
+class Binomial;
+
 class Generator {
+    friend class Alias;
+    friend class Generator64;
+    friend class Normal;
+    friend class Exponential;
+    friend class Poisson;
+    friend class Binomial;
+
 private:
     ojr_generator *cg;
     void _init(int);
+    explicit Generator(const ojr_generator *);
+
+    // Copies would share the C generator; use clone() instead.
+    Generator(const Generator &);
+    Generator &operator=(const Generator &);
 
 public:
     Generator(void);
     Generator(const char *);
     ~Generator(void);
 
-    void seed(Seed);
+#if __cplusplus >= 201103L
+    // Moves take the C generator and leave the source empty.
+    Generator(Generator &&) noexcept;
+    Generator &operator=(Generator &&) noexcept;
+
+    // Independent generator with the same algorithm, state and buffer.
+    Generator clone(void) const;
+#endif
+
+    void seed(const Seed &);
+    void seed(const uint32_t *, int);
     void seed(int);
     void seed(void);
-    void reseed(Seed);
+    void reseed(const Seed &);
+    void reseed(const uint32_t *, int);
+
+    void seed(const uint32_t *first, const uint32_t *last) {
+        this->seed(first, (int)(last - first));
+    }
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    void seed(std::span<const uint32_t> s) {
+        this->seed(s.data(), (int)s.size());
+    }
+#endif
+
+    /* Seed from any other range of 32-bit words, copied to the stack if
+     * there are no more than 64 of them.
+     */
+    template<typename ForwardIt>
+    void seed(ForwardIt first, ForwardIt last) {
+        uint32_t w[64];
+        int n = (int)std::distance(first, last);
+
+        if (n > 64) {
+            this->seed(Seed(first, last));
+            return;
+        }
+        std::copy(first, last, w);
+        this->seed(w, n);
+    }
 
     uint16_t next16(void);
     uint32_t next32(void);
@@ -217,26 +508,719 @@ public:
     int rand(int);
     void discard(int);
 
-    template<typename T>
-    void shuffle(std::vector<T> &vec, int count) {
-        int i, r, size = vec.size();
-        T t;
+    // Bulk versions of the above, through the library's fill functions.
+    void fillDouble(double *, int);
+    void fillNormal(double *, int);
+    void fillExponential(double *, int);
+    void fillRand(uint32_t, uint32_t *, int);
+
+    /* Uniform random bit generator, so std::shuffle and the <random>
+     * distributions can use it directly. Only a refill is out of line.
+     */
+    typedef uint32_t result_type;
+    static OJR_CONSTEXPR result_type min(void) { return 0; }
+    static OJR_CONSTEXPR result_type max(void) { return 0xFFFFFFFF; }
+    result_type operator()(void) { return OJR_NEXT32(this->cg); }
+
+    int setNormalLayers(int);
+    int setExponentialLayers(int);
+
+    /* Move to the front a random <count> of the elements in [first, last),
+     * in random order, swapping with swap() so that elements with their own
+     * swap (or, in C++11, move constructors) aren't copied. Gives the same
+     * permutation as ojr_shuffle().
+     */
+    template<typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last, int64_t count) {
+        using std::swap;
+        int k, n;
+        int64_t i, size = last - first, r[OJR_SHUFFLE_BATCH];
 
         if (size < 2) return;
         if (count == size) --count;
 
-        for (i = 0; i < count; ++i) {
-            r = ojr_rand(this->cg, size - i);
-            t = vec[i]; vec[i] = vec[i + r]; vec[i + r] = t;
+        for (i = 0; i < count; i += n) {
+            n = (count - i < OJR_SHUFFLE_BATCH) ? (int)(count - i) :
+                OJR_SHUFFLE_BATCH;
+            ojr_shuffle_targets(this->cg, size, i, r, n);
+            for (k = 0; k < n; ++k) {
+                if (r[k] != i + k) swap(first[i + k], first[r[k]]);
+            }
         }
     }
 
+    template<typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        this->shuffle(first, last, last - first);
+    }
+
+    template<typename T>
+    void shuffle(std::vector<T> &vec, int count) {
+        this->shuffle(vec.begin(), vec.end(), count);
+    }
+
     template<typename T>
     void shuffle(std::vector<T> &vec) {
-        this->shuffle(vec, vec.size());
+        this->shuffle(vec.begin(), vec.end());
+    }
+
+    // Cache-blocked shuffle for large vectors of plain data
+    template<typename T>
+    void parallelShuffle(std::vector<T> &vec, int threads = 0) {
+        if (vec.size() < 2) return;
+        ojr_parallel_shuffle(this->cg, &vec[0], vec.size(), sizeof(T),
+            threads);
+    }
+};
+
+/* The same stream 64 bits at a time, for distributions that would take
+ * two 32-bit calls. Refers to the generator, which must outlive it.
+ */
+class Generator64 {
+private:
+    ojr_generator *cg;
+
+public:
+    explicit Generator64(Generator &g) : cg(g.cg) {}
+
+    typedef uint64_t result_type;
+    static OJR_CONSTEXPR result_type min(void) { return 0; }
+    static OJR_CONSTEXPR result_type max(void) { return ~(result_type)0; }
+    result_type operator()(void) { return OJR_NEXT64(this->cg); }
+};
+
+/* Reusable alias table for weighted choice. Not copyable.
+ */
+class Alias {
+private:
+    ojr_alias *ca;
+    Alias(const Alias &);
+    Alias &operator=(const Alias &);
+
+public:
+    Alias(const std::vector<double> &);
+    ~Alias(void);
+
+    int size(void) const;
+    int next(void);
+    int next(Generator &);
+    void fill(std::vector<int> &);
+    void fill(Generator &, std::vector<int> &);
+};
+
+/* Distribution objects, which work out their constants once so that each
+ * draw needn't. Each has operator() for single values and fill() for
+ * arrays, which for a Generator goes through the library's fill functions.
+ * Uniform integers and reals take any engine with 32-bit output, such as
+ * Engine<> below; the others need the ziggurats or tables of a Generator.
+ */
+namespace detail {
+
+// Double in [0, 1) from the next 64 bits, as nextDouble() makes it.
+template<typename E>
+inline double unitDouble(E &e) {
+    uint64_t r = e();
+    r = (r << 32) | e();
+    return (double)(r & (((uint64_t)1 << 52) - 1)) *
+        (1.0 / 4503599627370496.0);
+}
+
+inline double unitDouble(Generator &g) { return g.nextDouble(); }
+
+} /* namespace detail */
+
+/* Integers from <lo> to <hi> inclusive. The threshold for Lemire's method
+ * is 2^32 mod the range, so that's computed here rather than per draw.
+ * Draws the same values as ojr_rand32() from the same stream.
+ */
+class UniformInt {
+private:
+    int32_t lo;
+    uint32_t range;         // hi - lo + 1, or 0 for all 2^32 values
+    uint32_t threshold;
+
+public:
+    typedef int32_t result_type;
+
+    UniformInt(int32_t lo, int32_t hi) : lo(lo),
+        range((uint32_t)hi - (uint32_t)lo + 1),
+        threshold(range ? (0 - range) % range : 0) {
+        if (hi < lo) throw std::invalid_argument("oj::UniformInt: hi < lo");
+    }
+
+    template<typename E>
+    result_type operator()(E &e) const {
+        if (0 == this->range) return (result_type)((uint32_t)this->lo + e());
+
+        uint64_t m = (uint64_t)e() * this->range;
+        while ((uint32_t)m < this->threshold) {
+            m = (uint64_t)e() * this->range;
+        }
+        return (result_type)((uint32_t)this->lo + (uint32_t)(m >> 32));
+    }
+
+    template<typename E>
+    void fill(E &e, result_type *a, int count) const {
+        for (int i = 0; i < count; ++i) a[i] = (*this)(e);
+    }
+
+    void fill(Generator &g, result_type *a, int count) const {
+        if (0 == this->range) {
+            for (int i = 0; i < count; ++i) a[i] = (*this)(g);
+            return;
+        }
+        uint32_t *u = reinterpret_cast<uint32_t *>(a);
+        g.fillRand(this->range, u, count);
+        for (int i = 0; i < count; ++i) u[i] += (uint32_t)this->lo;
+    }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) const {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
+};
+
+// Reals in [a, b).
+class UniformReal {
+private:
+    double offset, scale;
+
+public:
+    typedef double result_type;
+
+    UniformReal(double a = 0.0, double b = 1.0) : offset(a), scale(b - a) {
+        if (! (b >= a)) throw std::invalid_argument("oj::UniformReal: b < a");
+    }
+
+    template<typename E>
+    result_type operator()(E &e) const {
+        return this->offset + this->scale * detail::unitDouble(e);
+    }
+
+    template<typename E>
+    void fill(E &e, double *a, int count) const {
+        for (int i = 0; i < count; ++i) a[i] = (*this)(e);
+    }
+
+    void fill(Generator &g, double *a, int count) const {
+        g.fillDouble(a, count);
+        for (int i = 0; i < count; ++i) {
+            a[i] = this->offset + this->scale * a[i];
+        }
+    }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) const {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
+};
+
+class Normal {
+private:
+    double mu, sigma;
+
+public:
+    typedef double result_type;
+
+    Normal(double mu = 0.0, double sigma = 1.0) : mu(mu), sigma(sigma) {
+        if (! (sigma >= 0.0)) {
+            throw std::invalid_argument("oj::Normal: sigma < 0");
+        }
+    }
+
+    result_type operator()(Generator &g) const {
+        return this->mu + this->sigma * ojr_next_normal(g.cg);
+    }
+
+    void fill(Generator &g, double *a, int count) const {
+        ojr_fill_normal(g.cg, a, count);
+        for (int i = 0; i < count; ++i) a[i] = this->mu + this->sigma * a[i];
     }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) const {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
 };
 
+// Exponential with the given mean.
+class Exponential {
+private:
+    double scale;
+
+public:
+    typedef double result_type;
+
+    explicit Exponential(double scale = 1.0) : scale(scale) {
+        if (! (scale > 0.0)) {
+            throw std::invalid_argument("oj::Exponential: scale <= 0");
+        }
+    }
+
+    result_type operator()(Generator &g) const {
+        return this->scale * ojr_next_exponential(g.cg);
+    }
+
+    void fill(Generator &g, double *a, int count) const {
+        ojr_fill_exponential(g.cg, a, count);
+        for (int i = 0; i < count; ++i) a[i] *= this->scale;
+    }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) const {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
+};
+
+class Poisson {
+private:
+    ojr_poisson p;
+
+public:
+    typedef int64_t result_type;
+
+    explicit Poisson(double mean) {
+        if (! (mean >= 0.0)) {
+            throw std::invalid_argument("oj::Poisson: mean < 0");
+        }
+        ojr_poisson_init(&this->p, mean);
+    }
+
+    result_type operator()(Generator &g) {
+        return ojr_next_poisson(g.cg, &this->p);
+    }
+
+    void fill(Generator &g, int64_t *a, int count) {
+        ojr_fill_poisson(g.cg, &this->p, a, count);
+    }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
+};
+
+class Binomial {
+private:
+    ojr_binomial b;
+
+public:
+    typedef int64_t result_type;
+
+    Binomial(int64_t n, double p) {
+        if (n < 0 || ! (p >= 0.0 && p <= 1.0)) {
+            throw std::invalid_argument("oj::Binomial: bad n or p");
+        }
+        ojr_binomial_init(&this->b, n, p);
+    }
+
+    result_type operator()(Generator &g) {
+        return ojr_next_binomial(g.cg, &this->b);
+    }
+
+    void fill(Generator &g, int64_t *a, int count) {
+        ojr_fill_binomial(g.cg, &this->b, a, count);
+    }
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    template<typename E>
+    void fill(E &e, std::span<result_type> s) {
+        this->fill(e, s.data(), (int)s.size());
+    }
+#endif
+};
+
+#if __cplusplus >= 201103L
+
+/* Header-only engines. Each algorithm below does the same arithmetic as its
+ * C version, and Engine<> keeps the state and buffer as members and calls
+ * the algorithm directly, so there's no allocation and no indirect call.
+ * An Engine seeded the same way as an ojr_generator of the same algorithm
+ * gives the same stream, including next64() and nextDouble(). Reseeding
+ * leaves buffered output alone, so that stays true across a reseed only
+ * if the buffer is the default size.
+ *
+ * In C++14 and later everything but system seeding is constexpr, so tables
+ * can be computed at compile time into read-only data:
+ *
+ *     constexpr oj::Table<uint64_t, 64> zobrist =
+ *         oj::randomTable<uint64_t, 64, oj::MT19937>(42);
+ */
+namespace detail {
+
+OJR_CONSTEXPR14 void defaultSeed(uint32_t *s, int n, const uint32_t *seed,
+int size) {
+    uint32_t x = 232497429;
+
+    for (int i = 0, j = 0; i < n; ++i) {
+        x = (69069 * x) + 764385 + seed[j];
+        s[i] = x;
+        if (++j >= size) j = 0;
+    }
+}
+
+OJR_CONSTEXPR14 void defaultReseed(uint32_t *s, int n, const uint32_t *seed,
+int size) {
+    for (int i = 0, j = 0; i < n; ++i) {
+        s[i] ^= seed[j];
+        if (++j >= size) j = 0;
+    }
+}
+
+} /* namespace detail */
+
+/* Algorithms give their sizes, whether the buffer must be exactly <bufsize>
+ * words, and seed(), reseed() and refill() on a state and buffer. Refill
+ * writes the buffer backwards, since engines hand it out from the end.
+ */
+struct JKISS127 {
+    enum { seedsize = 4, statesize = 4, bufsize = 256, fixedbuf = 0 };
+
+    static OJR_CONSTEXPR14 void fixup(uint32_t *s) {
+        if (0 == s[1]) s[1] = 1;
+        s[3] = s[3] % 698769068 + 1;
+    }
+    static OJR_CONSTEXPR14 void seed(uint32_t *s, uint32_t *,
+    const uint32_t *seed, int size) {
+        detail::defaultSeed(s, statesize, seed, size);
+        fixup(s);
+    }
+    static OJR_CONSTEXPR14 void reseed(uint32_t *s, uint32_t *,
+    const uint32_t *seed, int size) {
+        detail::defaultReseed(s, statesize, seed, size);
+        fixup(s);
+    }
+    static OJR_CONSTEXPR14 void refill(uint32_t *s, uint32_t *buf, int n) {
+        uint32_t a = s[0], b = s[1], c = s[2], d = s[3];
+
+        for (uint32_t *bp = buf + n; bp > buf; ) {
+            a = 314527869 * a + 1234567;
+            b ^= b << 5;
+            b ^= b >> 7;
+            b ^= b << 22;
+            uint64_t t = 4294584393ULL * c + d;
+            d = (uint32_t)(t >> 32);
+            c = (uint32_t)t;
+            *--bp = a + b + c;
+        }
+        s[0] = a; s[1] = b; s[2] = c; s[3] = d;
+    }
+};
+
+struct MT19937 {
+    enum { seedsize = 16, statesize = 624, bufsize = 624, fixedbuf = 1 };
+
+    static OJR_CONSTEXPR14 void seed(uint32_t *s, uint32_t *,
+    const uint32_t *seed, int size) {
+        const int n = statesize;
+        int i = 0, j = 0, k = 0;
+
+        s[0] = (1 == size) ? seed[0] : 19650218U;
+        for (i = 1; i < n; ++i) {
+            s[i] = (1812433253U * (s[i - 1] ^ (s[i - 1] >> 30)) + i);
+        }
+        if (1 == size) return;
+
+        i = 1;
+        j = 0;
+        for (k = (n > size) ? n : size; k > 0; --k) {
+            s[i] = (s[i] ^ ((s[i - 1] ^ (s[i - 1] >> 30)) * 1664525U)) +
+                seed[j] + j;
+            if (++i >= n) { s[0] = s[n - 1]; i = 1; }
+            if (++j >= size) j = 0;
+        }
+        for (k = n - 1; k > 0; --k) {
+            s[i] = (s[i] ^ ((s[i - 1] ^ (s[i - 1] >> 30)) * 1566083941U)) - i;
+            if (++i >= n) { s[0] = s[n - 1]; i = 1; }
+        }
+        s[0] = 0x80000000;
+    }
+    static OJR_CONSTEXPR14 void reseed(uint32_t *s, uint32_t *,
+    const uint32_t *seed, int size) {
+        detail::defaultReseed(s, statesize, seed, size);
+        s[0] = 0x80000000;
+    }
+    static OJR_CONSTEXPR14 void refill(uint32_t *s, uint32_t *buf, int) {
+        const int n = statesize;
+        uint32_t y = 0, *bp = buf + n;
+
+        for (int i = 0; i < n; ++i) {
+            int j = (i + 1 < n) ? i + 1 : i + 1 - n;
+            int k = (i + 397 < n) ? i + 397 : i + 397 - n;
+
+            y = (s[i] & 0x80000000) | (s[j] & 0x7FFFFFFF);
+            s[i] = s[k] ^ (y >> 1) ^ ((s[j] & 1) ? 0x9908b0df : 0);
+        }
+        for (int i = 0; i < n; ++i) {
+            y = s[i] ^ (s[i] >> 11);
+            y ^= (y << 7) & 0x9d2c5680U;
+            y ^= (y << 15) & 0xefc60000U;
+            *--bp = y ^ (y >> 18);
+        }
+    }
+};
+
+// The buffer is the state here; <s> only holds the carry.
+struct MWC8222 {
+    enum { seedsize = 16, statesize = 1, bufsize = 256, fixedbuf = 1 };
+
+    static OJR_CONSTEXPR14 void seed(uint32_t *s, uint32_t *buf,
+    const uint32_t *seed, int size) {
+        detail::defaultSeed(buf, bufsize, seed, size);
+        s[0] = 362436;
+    }
+    static OJR_CONSTEXPR14 void reseed(uint32_t *, uint32_t *buf,
+    const uint32_t *seed, int size) {
+        detail::defaultReseed(buf, bufsize, seed, size);
+    }
+    static OJR_CONSTEXPR14 void refill(uint32_t *s, uint32_t *buf, int) {
+        uint32_t c = s[0];
+
+        for (int i = bufsize - 1; i >= 0; --i) {
+            uint64_t t = 809430660ULL * buf[i] + c;
+            c = (uint32_t)(t >> 32);
+            buf[i] = (uint32_t)t;
+        }
+        s[0] = c;
+    }
+};
+
+/* Engine with state and buffer inline, copyable and movable like any plain
+ * struct. <BufSize> may be anything for algorithms without a fixed buffer.
+ */
+template<typename Algorithm, int BufSize = Algorithm::bufsize>
+class Engine {
+    static_assert(BufSize > 0 && (! Algorithm::fixedbuf ||
+        BufSize == (int)Algorithm::bufsize), "oj::Engine: bad buffer size");
+
+private:
+    uint32_t state[Algorithm::statesize] = {};
+    uint32_t buf[BufSize] = {};
+    int left = 0;   // Words left in buf, handed out from the end
+
+public:
+    typedef uint32_t result_type;
+    static constexpr result_type min(void) { return 0; }
+    static constexpr result_type max(void) { return 0xFFFFFFFF; }
+
+    Engine(void) { this->seed(); }
+    OJR_CONSTEXPR14 explicit Engine(int value) { this->seed(value); }
+    OJR_CONSTEXPR14 Engine(const uint32_t *s, int size) {
+        this->seed(s, size);
+    }
+
+    OJR_CONSTEXPR14 void seed(const uint32_t *s, int size) {
+        Algorithm::seed(this->state, this->buf, s, size);
+        this->left = 0;
+    }
+    void seed(const Seed &v) { this->seed(v.data(), (int)v.size()); }
+    OJR_CONSTEXPR14 void seed(int value) {
+        uint32_t s = (uint32_t)value;
+        this->seed(&s, 1);
+    }
+    void seed(void) {
+        uint32_t s[Algorithm::seedsize];
+        ojr_get_system_entropy(s, Algorithm::seedsize);
+        this->seed(s, Algorithm::seedsize);
+    }
+    OJR_CONSTEXPR14 void reseed(const uint32_t *s, int size) {
+        Algorithm::reseed(this->state, this->buf, s, size);
+    }
+    void reseed(const Seed &v) { this->reseed(v.data(), (int)v.size()); }
+
+    OJR_CONSTEXPR14 result_type operator()(void) {
+        if (0 == this->left) {
+            Algorithm::refill(this->state, this->buf, BufSize);
+            this->left = BufSize;
+        }
+        return this->buf[--this->left];
+    }
+    OJR_CONSTEXPR14 uint32_t next32(void) { return (*this)(); }
+    OJR_CONSTEXPR14 uint64_t next64(void) {
+        uint64_t r = (*this)();
+        return (r << 32) | (*this)();
+    }
+    // The same value as the C library's bit twiddling, but constexpr.
+    OJR_CONSTEXPR14 double nextDouble(void) {
+        return (double)(this->next64() & 0xFFFFFFFFFFFFFull) *
+            (1.0 / 4503599627370496.0);
+    }
+    OJR_CONSTEXPR14 void discard(unsigned long long count) {
+        while (count > 0) {
+            if (0 == this->left) {
+                Algorithm::refill(this->state, this->buf, BufSize);
+                this->left = BufSize;
+            }
+            int n = (count < (unsigned long long)this->left) ?
+                (int)count : this->left;
+            this->left -= n;
+            count -= n;
+        }
+    }
+};
+
+#endif /* C++11 */
+
+#if __cplusplus >= 201402L
+
+/* Fixed table of random unsigned integers from an engine seeded with
+ * <seed>: each entry is next64() if the type is wider than 32 bits, and
+ * next32() otherwise. Table is a plain array, as std::array can't be
+ * written in a constant expression before C++17.
+ */
+template<typename T, int N>
+struct Table {
+    T v[N];
+
+    constexpr const T &operator[](int i) const { return v[i]; }
+    constexpr int size(void) const { return N; }
+    constexpr const T *begin(void) const { return v; }
+    constexpr const T *end(void) const { return v + N; }
+};
+
+template<typename T, int N, typename Algorithm = JKISS127>
+constexpr Table<T, N> randomTable(int seed) {
+    Table<T, N> t = {};
+    Engine<Algorithm> e(seed);
+
+    for (int i = 0; i < N; ++i) {
+        t.v[i] = (sizeof(T) > 4) ? (T)e.next64() : (T)e.next32();
+    }
+    return t;
+}
+
+#endif /* C++14 */
+
+#if defined(__cpp_lib_ranges)
+
+/* Endless random streams as lazy views, for the standard range algorithms
+ * and adaptors, as in
+ *
+ *     std::ranges::copy(oj::views::normal(g, 10.0, 2.0)
+ *         | std::views::take(n), out);
+ *
+ * Values are made a chunk at a time with the generator's bulk fills, so a
+ * view may take up to a chunk more from the generator than is read from
+ * it. Views are input ranges that refer to the generator, which must
+ * outlive them.
+ */
+namespace views {
+
+template<typename T, typename Fill>
+class StreamView : public std::ranges::view_interface<StreamView<T, Fill> > {
+public:
+    enum { CHUNK = 256 };
+
+private:
+    Fill fill;
+    T buf[CHUNK];
+    int pos;
+
+public:
+    class iterator {
+    private:
+        StreamView *v;
+
+    public:
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+
+        iterator(void) : v(nullptr) {}
+        explicit iterator(StreamView *sv) : v(sv) {}
+
+        /* The chunk is refilled when it runs out, whether the next value
+         * is being read or stepped past, so skipped values still use up
+         * the stream as read ones do.
+         */
+        T operator*(void) const {
+            if (CHUNK == v->pos) {
+                v->fill(v->buf, CHUNK);
+                v->pos = 0;
+            }
+            return v->buf[v->pos];
+        }
+        iterator &operator++(void) {
+            if (CHUNK == v->pos) **this;
+            ++v->pos;
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+    };
+
+    explicit StreamView(Fill f) : fill(f), pos(CHUNK) {}
+
+    iterator begin(void) { return iterator(this); }
+    std::unreachable_sentinel_t end(void) const { return {}; }
+};
+
+namespace detail {
+
+struct UniformFill {
+    Generator *g;
+    void operator()(double *a, int n) const { g->fillDouble(a, n); }
+};
+
+struct NormalFill {
+    Generator *g;
+    double mu, sigma;
+    void operator()(double *a, int n) const {
+        g->fillNormal(a, n);
+        for (int i = 0; i < n; ++i) a[i] = mu + sigma * a[i];
+    }
+};
+
+struct ExponentialFill {
+    Generator *g;
+    double scale;
+    void operator()(double *a, int n) const {
+        g->fillExponential(a, n);
+        for (int i = 0; i < n; ++i) a[i] *= scale;
+    }
+};
+
+struct BoundedFill {
+    Generator *g;
+    uint32_t limit;
+    void operator()(uint32_t *a, int n) const { g->fillRand(limit, a, n); }
+};
+
+} /* namespace detail */
+
+// Doubles in [0, 1).
+inline StreamView<double, detail::UniformFill> uniform(Generator &g) {
+    return StreamView<double, detail::UniformFill>({ &g });
+}
+
+inline StreamView<double, detail::NormalFill>
+normal(Generator &g, double mu = 0.0, double sigma = 1.0) {
+    return StreamView<double, detail::NormalFill>({ &g, mu, sigma });
+}
+
+inline StreamView<double, detail::ExponentialFill>
+exponential(Generator &g, double scale = 1.0) {
+    return StreamView<double, detail::ExponentialFill>({ &g, scale });
+}
+
+// Integers from 0 to <limit>-1, each equally likely.
+inline StreamView<uint32_t, detail::BoundedFill>
+bounded(Generator &g, uint32_t limit) {
+    return StreamView<uint32_t, detail::BoundedFill>({ &g, limit });
+}
+
+} /* namespace views */
+
+#endif /* __cpp_lib_ranges */
+
 } /* namespace */
 #endif /* __cplusplus for class definition */
 
@@ -0,0 +1,154 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Random permutations of [0, n) that are computed rather than stored, so
+ * any element of one can be had in O(1) time and memory however large n
+ * is. The permutation is a Feistel network on the smallest number of bits
+ * that covers n, keyed by the generator, and values that land outside
+ * [0, n) are fed through again ("cycle-walking") until one lands inside.
+ * That leaves a bijection on [0, n), and since the network covers less
+ * than 2n values, it takes under two passes on average. Networks on a
+ * few bits are far from uniform, so small permutations are just stored.
+ *
+ * The round function is 32-bit multiply and xorshift, so contiguous ranges
+ * are done a block at a time with each round applied across the block,
+ * which compilers turn into vector code. Blocks are bigger than a compiler
+ * would unroll completely, since that defeats the vectorizer.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+#define LANES 64
+
+ojr_permutation *ojr_permutation_new(ojr_generator *g, int64_t n) {
+    int i, bits;
+    ojr_permutation *pp;
+
+    assert(0x5eed1e55 == g->init);
+    assert(n > 0);
+    if (NULL == (pp = malloc(sizeof(ojr_permutation)))) return NULL;
+
+    for (bits = 2; bits < 63; ++bits) {
+        if (((int64_t)1 << bits) >= n) break;
+    }
+    pp->n = n;
+    if (n <= OJR_PERM_SMALL) {
+        for (i = 0; i < n; ++i) pp->small[i] = (uint8_t)i;
+        ojr_shuffle(g, pp->small, n, 1, n);
+        return pp;
+    }
+    pp->hbits = bits - bits / 2;
+    pp->lbits = bits / 2;
+    for (i = 0; i < 2 * OJR_PERM_ROUNDS; ++i) pp->keys[i] = ojr_next32(g);
+    return pp;
+}
+
+void ojr_permutation_free(ojr_permutation *pp) {
+    assert(NULL != pp);
+    free(pp);
+}
+
+// Top <bits> bits of a keyed hash of <x>.
+static inline uint32_t feistelf(uint32_t x, const uint32_t *k, int bits) {
+    x = (x ^ k[0]) * 0x9E3779B1;
+    x ^= x >> 15;
+    x = (x + k[1]) * 0x85EBCA6B;
+    x ^= x >> 13;
+    return x >> (32 - bits);
+}
+
+/* One pass through the network. The halves are of <hbits> and <lbits>,
+ * which may differ by one, so rounds are taken in pairs, updating the high
+ * half from the low and then the low from the high.
+ */
+static inline uint64_t feistel(const ojr_permutation *pp, uint64_t x) {
+    int r;
+    uint32_t h = (uint32_t)(x >> pp->lbits);
+    uint32_t l = (uint32_t)x & (((uint32_t)1 << pp->lbits) - 1);
+
+    for (r = 0; r < OJR_PERM_ROUNDS; r += 2) {
+        h ^= feistelf(l, pp->keys + 2 * r, pp->hbits);
+        l ^= feistelf(h, pp->keys + 2 * r + 2, pp->lbits);
+    }
+    return ((uint64_t)h << pp->lbits) | l;
+}
+
+static inline int64_t permute(const ojr_permutation *pp, int64_t i) {
+    uint64_t x = (uint64_t)i;
+
+    if (pp->n <= OJR_PERM_SMALL) return pp->small[i];
+    do {
+        x = feistel(pp, x);
+    } while (x >= (uint64_t)pp->n);
+    return (int64_t)x;
+}
+
+// Return element <index> of the permutation.
+int64_t ojr_permutation_at(ojr_permutation *pp, int64_t index) {
+    assert(index >= 0 && index < pp->n);
+    return permute(pp, index);
+}
+
+/* One pass through the network for each of <m> values at once, which
+ * compilers can vectorize.
+ */
+static void feistelblock(const ojr_permutation *pp, uint64_t *x, int m) {
+    int j, r, hbits = pp->hbits, lbits = pp->lbits;
+    uint32_t h[LANES], l[LANES];
+    const uint32_t *k;
+
+    for (j = 0; j < m; ++j) {
+        h[j] = (uint32_t)(x[j] >> lbits);
+        l[j] = (uint32_t)x[j] & (((uint32_t)1 << lbits) - 1);
+    }
+    for (r = 0; r < OJR_PERM_ROUNDS; r += 2) {
+        k = pp->keys + 2 * r;
+        for (j = 0; j < m; ++j) h[j] ^= feistelf(l[j], k, hbits);
+        for (j = 0; j < m; ++j) l[j] ^= feistelf(h[j], k + 2, lbits);
+    }
+    for (j = 0; j < m; ++j) x[j] = ((uint64_t)h[j] << lbits) | l[j];
+}
+
+/* Fill <out> with elements <start> through <start>+<count>-1, a block of
+ * LANES at a time. After each pass, those that fell outside [0, n) are
+ * packed together to go round again, so every pass is a full vector loop.
+ */
+void ojr_permutation_range(ojr_permutation *pp, int64_t start, int64_t *out,
+int count) {
+    int i, j, m, nm, lane[LANES];
+    uint64_t x[LANES];
+
+    assert(start >= 0 && count >= 0 && start + count <= pp->n);
+
+    if (pp->n <= OJR_PERM_SMALL) {
+        for (i = 0; i < count; ++i) out[i] = pp->small[start + i];
+        return;
+    }
+    for (i = 0; i < count; i += LANES) {
+        m = (count - i < LANES) ? count - i : LANES;
+        for (j = 0; j < m; ++j) {
+            x[j] = (uint64_t)(start + i + j);
+            lane[j] = i + j;
+        }
+        while (m > 0) {
+            feistelblock(pp, x, m);
+            for (nm = 0, j = 0; j < m; ++j) {
+                if (x[j] < (uint64_t)pp->n) {
+                    out[lane[j]] = (int64_t)x[j];
+                } else {
+                    x[nm] = x[j];
+                    lane[nm++] = lane[j];
+                }
+            }
+            m = nm;
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Reservoir sampling of k items from a stream of unknown length. The
+ * unweighted version is Li's Algorithm L, which jumps geometrically over
+ * items that won't be taken, so the generator is used O(k log(n/k)) times.
+ * The weighted version is Efraimidis and Spirakis' A-ExpJ, keeping keys as
+ * logarithms so they come straight from the exponential.
+ *
+ * The caller keeps the items: offering one returns the slot from 0 to k-1
+ * in which to store it, or -1 to drop it.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "ojrandlib.h"
+
+ojr_reservoir *ojr_reservoir_new(int k, int weighted) {
+    ojr_reservoir *rp;
+
+    assert(k > 0);
+    if (NULL == (rp = calloc(1, sizeof(ojr_reservoir)))) return NULL;
+    rp->k = k;
+    rp->weighted = weighted;
+
+    if (weighted) {
+        rp->keys = malloc(k * sizeof(double));
+        rp->slots = malloc(k * sizeof(int));
+        if (NULL == rp->keys || NULL == rp->slots) {
+            ojr_reservoir_free(rp);
+            return NULL;
+        }
+    }
+    return rp;
+}
+
+void ojr_reservoir_free(ojr_reservoir *rp) {
+    assert(NULL != rp);
+    free(rp->slots);
+    free(rp->keys);
+    free(rp);
+}
+
+// Index of the item following a geometric jump with parameter W.
+static void jump(ojr_generator *g, ojr_reservoir *rp) {
+    double s = floor(-ojr_next_exponential(g) / log1p(-rp->w));
+
+    if (s > 9e18) rp->next = INT64_MAX;
+    else rp->next += (int64_t)s + 1;
+}
+
+int ojr_reservoir_offer(ojr_generator *g, ojr_reservoir *rp) {
+    int64_t i = rp->seen++;
+    assert(! rp->weighted);
+
+    if (i < rp->k) {
+        if (i == rp->k - 1) {
+            rp->w = exp(-ojr_next_exponential(g) / rp->k);
+            rp->next = i;
+            jump(g, rp);
+        }
+        return (int)i;
+    }
+    if (i < rp->next) return -1;
+
+    rp->w *= exp(-ojr_next_exponential(g) / rp->k);
+    jump(g, rp);
+    return ojr_rand32(g, rp->k);
+}
+
+/* Mark as seen all the items that the next offer would drop, and return
+ * how many there are, so callers that can skip through their stream don't
+ * have to offer each one.
+ */
+int64_t ojr_reservoir_skip(ojr_reservoir *rp) {
+    int64_t s;
+    assert(! rp->weighted);
+
+    if (rp->seen < rp->k) return 0;
+    s = rp->next - rp->seen;
+    rp->seen = rp->next;
+    return s;
+}
+
+// Min-heap of log keys, with the slot each came from.
+
+static void siftdown(ojr_reservoir *rp, int i, int n) {
+    int c, s = rp->slots[i];
+    double key = rp->keys[i];
+
+    while ((c = 2 * i + 1) < n) {
+        if (c + 1 < n && rp->keys[c + 1] < rp->keys[c]) ++c;
+        if (key <= rp->keys[c]) break;
+        rp->keys[i] = rp->keys[c];
+        rp->slots[i] = rp->slots[c];
+        i = c;
+    }
+    rp->keys[i] = key;
+    rp->slots[i] = s;
+}
+
+static void siftup(ojr_reservoir *rp, int i) {
+    int p, s = rp->slots[i];
+    double key = rp->keys[i];
+
+    while (i > 0 && key < rp->keys[p = (i - 1) / 2]) {
+        rp->keys[i] = rp->keys[p];
+        rp->slots[i] = rp->slots[p];
+        i = p;
+    }
+    rp->keys[i] = key;
+    rp->slots[i] = s;
+}
+
+/* Offer an item with the given <weight>. Items with zero weight are never
+ * taken. Keys are log(U)/weight, and the amount of weight to jump over is
+ * log(U)/log(T) for T the smallest key in the reservoir.
+ */
+int ojr_reservoir_offer_weighted(ojr_generator *g, ojr_reservoir *rp,
+double weight) {
+    int s, n = rp->filled;
+    double t;
+    assert(rp->weighted && weight >= 0.0);
+
+    ++rp->seen;
+    if (! (weight > 0.0)) return -1;
+
+    if (n < rp->k) {
+        rp->keys[n] = -ojr_next_exponential(g) / weight;
+        rp->slots[n] = n;
+        siftup(rp, n);
+        rp->filled = ++n;
+
+        if (n == rp->k) rp->jump = ojr_next_exponential(g) / -rp->keys[0];
+        return n - 1;
+    }
+    rp->jump -= weight;
+    if (rp->jump > 0.0) return -1;
+
+    t = exp(weight * rp->keys[0]);
+    t += ojr_next_double(g) * (1.0 - t);
+    rp->keys[0] = log(t) / weight;
+    s = rp->slots[0];
+    siftdown(rp, 0, n);
+
+    rp->jump = ojr_next_exponential(g) / -rp->keys[0];
+    return s;
+}
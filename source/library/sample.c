@@ -0,0 +1,194 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Choosing k distinct indices from 0 to n-1 without an array of n. Sorted
+ * samples use Vitter's Algorithm D, which jumps from one chosen index to
+ * the next by drawing the length of each skip, so it takes O(k) time and
+ * no memory beyond the output. Unsorted ones use Floyd's algorithm, which
+ * is simpler and faster when k is small but needs a set of those chosen.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "ojrandlib.h"
+
+/* Vitter's constant: switch to Algorithm A once the indices still to pick
+ * are at least 1/13 of those remaining, that is once n <= 13k.
+ */
+#define ALPHAINV 13
+
+// U^(1/k) for U uniform on (0, 1], which is exp(-E/k).
+static inline double rootu(ojr_generator *g, double kinv) {
+    return exp(-ojr_next_exponential(g) * kinv);
+}
+
+/* Algorithm A, for when the sample is a sizeable part of what's left: walk
+ * along computing the probability of each skip length in turn.
+ */
+static void methoda(ojr_generator *g, int64_t n, int64_t k, int64_t pos,
+int64_t *out) {
+    int64_t s;
+    double v, quot, top = (double)(n - k), nreal = (double)n;
+
+    while (k >= 2) {
+        v = ojr_next_double(g);
+        s = 0;
+        quot = top / nreal;
+        while (quot > v) {
+            ++s;
+            top -= 1.0;
+            nreal -= 1.0;
+            quot = (quot * top) / nreal;
+        }
+        pos += s;
+        *out++ = pos++;
+        n -= s + 1;
+        nreal -= 1.0;
+        --k;
+    }
+    *out = pos + (int64_t)ojr_rand64(g, (uint64_t)n);
+}
+
+/* Fill <out> with <k> distinct indices from 0 to <n>-1 in increasing order,
+ * each k-subset being equally likely.
+ */
+void ojr_sample_indices(ojr_generator *g, int64_t n, int64_t k,
+int64_t *out) {
+    int64_t i, s, t, limit, qu1, pos = 0;
+    double x, u, y1, y2, top, bottom, nreal, qu1real, kinv, kmin1inv, vprime;
+    double threshold;
+
+    assert(0x5eed1e55 == g->init);
+    assert(n >= 0 && k >= 0 && k <= n);
+    if (k == n) {
+        for (i = 0; i < k; ++i) out[i] = i;
+        return;
+    }
+    if (0 == k) return;
+
+    kinv = 1.0 / k;
+    vprime = rootu(g, kinv);
+    qu1 = n - k + 1;
+    threshold = (double)ALPHAINV * k;
+
+    while (k > 1 && threshold < n) {
+        nreal = (double)n;
+        qu1real = (double)qu1;
+        kmin1inv = 1.0 / (k - 1);
+
+        while (1) {
+            // D2: skip length from a continuous approximation
+            while (1) {
+                x = nreal * (1.0 - vprime);
+                s = (int64_t)x;
+                if (s < qu1) break;
+                vprime = rootu(g, kinv);
+            }
+            u = 1.0 - ojr_next_double(g);
+
+            // D3: accept if under the quick bound
+            y1 = exp(log(u * nreal / qu1real) * kmin1inv);
+            vprime = y1 * (1.0 - x / nreal) * (qu1real / (qu1real - s));
+            if (vprime <= 1.0) break;
+
+            // D4: the exact test
+            y2 = 1.0;
+            top = nreal - 1.0;
+            if (k - 1 > s) {
+                bottom = nreal - k;
+                limit = n - s;
+            } else {
+                bottom = nreal - s - 1.0;
+                limit = qu1;
+            }
+            for (t = n - 1; t >= limit; --t) {
+                y2 = (y2 * top) / bottom;
+                top -= 1.0;
+                bottom -= 1.0;
+            }
+            if (nreal / (nreal - x) >= y1 * exp(log(y2) * kmin1inv)) {
+                vprime = rootu(g, kmin1inv);
+                break;
+            }
+            vprime = rootu(g, kinv);
+        }
+        // D5: skip <s> indices and take the next
+        pos += s;
+        *out++ = pos++;
+        n -= s + 1;
+        --k;
+        kinv = kmin1inv;
+        qu1 -= s;
+        threshold -= ALPHAINV;
+    }
+    if (k > 1) methoda(g, n, k, pos, out);
+    else *out = pos + (int64_t)ojr_rand64(g, (uint64_t)n);
+}
+
+// Slot for <t> in a table of 2^<bits> entries: Fibonacci hashing.
+static inline int64_t slot(int64_t t, int bits) {
+    return (int64_t)(((uint64_t)t * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+/* Add <t> to the set, or if it's already there add <j> instead, which
+ * never is. Return whichever was added. Empty entries are -1.
+ */
+static inline int64_t setadd(int64_t *set, int bits, int64_t t, int64_t j) {
+    int64_t h, mask = ((int64_t)1 << bits) - 1;
+
+    for (h = slot(t, bits); -1 != set[h]; h = (h + 1) & mask) {
+        if (set[h] == t) {
+            t = j;
+            for (h = slot(t, bits); -1 != set[h]; h = (h + 1) & mask) ;
+            break;
+        }
+    }
+    set[h] = t;
+    return t;
+}
+
+/* Fill <out> with <k> distinct indices from 0 to <n>-1 in random order, by
+ * Floyd's algorithm: for each j from n-k to n-1, take a random index up to
+ * j, or j itself if that one's already taken. A final shuffle makes every
+ * order of the sample equally likely too. What's been taken is kept in a
+ * hash table at most half full, or for small k (or if there's no memory
+ * for the table) found by scanning the output.
+ */
+void ojr_sample_indices_unsorted(ojr_generator *g, int64_t n, int64_t k,
+int64_t *out) {
+    int bits;
+    int64_t i, j, t, *set = NULL;
+
+    assert(0x5eed1e55 == g->init);
+    assert(n >= 0 && k >= 0 && k <= n);
+    if (0 == k) return;
+
+    for (bits = 1; ((int64_t)1 << bits) < 2 * k; ++bits) ;
+    if (k > 16 && NULL != (set = malloc(sizeof(int64_t) << bits))) {
+        memset(set, 0xFF, sizeof(int64_t) << bits);
+    }
+    for (i = 0, j = n - k; j < n; ++i, ++j) {
+        t = (int64_t)ojr_rand64(g, (uint64_t)j + 1);
+
+        if (set) {
+            t = setadd(set, bits, t, j);
+        } else {
+            for (int64_t h = 0; h < i; ++h) {
+                if (out[h] == t) {
+                    t = j;
+                    break;
+                }
+            }
+        }
+        out[i] = t;
+    }
+    free(set);
+    ojr_shuffle(g, out, k, sizeof(int64_t), k);
+}
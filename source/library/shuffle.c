@@ -0,0 +1,431 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Shuffles of arrays of any element size. On arrays too big for the cache,
+ * Fisher-Yates misses the cache and TLB on nearly every swap. The ordinary
+ * shuffle hides some of that by prefetching; the parallel one avoids it by
+ * scattering each element to one of a power of 2 of cache-sized buckets
+ * chosen uniformly at random, and then shuffling each bucket on its own as
+ * it is copied back. Given the bucket sizes, every assignment of elements
+ * to buckets is equally likely, so the concatenated buckets are a uniformly
+ * random permutation.
+ *
+ * The array is cut into a fixed number of chunks for the scatter, and each
+ * chunk and each bucket gets its own substream seeded from the caller's
+ * generator, so the result depends only on that generator and not on how
+ * many threads did the work. Threads are used if the library is built with
+ * OpenMP.
+ *
+ * Dealing hands from small decks is here too, as it uses the same indices.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+#ifdef _OPENMP
+#  include <omp.h>
+#  define THREADNUM() omp_get_thread_num()
+#  define PARALLEL_FOR \
+    _Pragma("omp parallel for num_threads(nt) schedule(dynamic)")
+#else
+#  define THREADNUM() 0
+#  define PARALLEL_FOR
+#endif
+
+#ifdef __GNUC__
+#  define PREFETCH(p) __builtin_prefetch((p), 1)
+#else
+#  define PREFETCH(p)
+#endif
+
+#define MAXPRODUCT 0x1000000000000ULL
+#define BUCKETBYTES (1 << 20)
+#define MAXBUCKETS 4096
+#define NCHUNKS 64
+#define SEEDWORDS 4
+
+/* Swap records a word at a time, with fixed-size copies the compiler can
+ * turn into plain loads and stores.
+ */
+static inline void swap(char *a, char *b, size_t size) {
+    uint32_t t4;
+    uint64_t t8;
+    char t;
+
+    for (; size >= 8; size -= 8, a += 8, b += 8) {
+        memcpy(&t8, a, 8); memcpy(a, b, 8); memcpy(b, &t8, 8);
+    }
+    if (size >= 4) {
+        memcpy(&t4, a, 4); memcpy(a, b, 4); memcpy(b, &t4, 4);
+        size -= 4; a += 4; b += 4;
+    }
+    for (; size > 0; --size, ++a, ++b) {
+        t = *a; *a = *b; *b = t;
+    }
+}
+
+static inline void copy(char *d, const char *s, size_t size) {
+    if (4 == size) memcpy(d, s, 4);
+    else if (8 == size) memcpy(d, s, 8);
+    else memcpy(d, s, size);
+}
+
+/* Bucket numbers are <shift> bits each, taken several at a time from 64-bit
+ * words, so the counting pass and its replay don't cost a word apiece.
+ */
+typedef struct _labels {
+    uint64_t r;
+    int left;
+} labels;
+
+static inline int nextlabel(ojr_generator *g, labels *lp, int shift) {
+    int b;
+
+    if (0 == lp->left) {
+        lp->r = OJR_NEXT64(g);
+        lp->left = 64 / shift;
+    }
+    b = (int)(lp->r & ((1 << shift) - 1));
+    lp->r >>= shift;
+    --lp->left;
+    return b;
+}
+
+// Inline copy of ojr_rand32() for the shuffle loops.
+static inline uint32_t index32(ojr_generator *g, uint32_t limit) {
+    uint64_t m;
+    uint32_t t;
+
+    m = (uint64_t)OJR_NEXT32(g) * limit;
+    if ((uint32_t)m < limit) {
+        t = -limit % limit;
+        while ((uint32_t)m < t) m = (uint64_t)OJR_NEXT32(g) * limit;
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Random index from 0 to limit-1 for limits that may exceed 32 bits.
+static inline uint64_t index64(ojr_generator *g, uint64_t limit) {
+    if (limit <= 0xFFFFFFFF) return index32(g, (uint32_t)limit);
+    return ojr_rand64(g, limit);
+}
+
+/* Multiply 64-bit <r> by <b> below 2^32, returning the high 32 bits of the
+ * 96-bit product and leaving the low 64 in <r>.
+ */
+static inline uint32_t mulshift(uint64_t *r, uint32_t b) {
+    uint64_t x = (*r & 0xFFFFFFFF) * b;
+    uint64_t y = (*r >> 32) * b + (x >> 32);
+
+    *r = (y << 32) | (x & 0xFFFFFFFF);
+    return (uint32_t)(y >> 32);
+}
+
+/* Several decreasing bounds whose product is at most MAXPRODUCT share one 64-bit
+ * word: each multiply-shift takes an index from the high bits and leaves
+ * the rest of the word for the next. The result is exact if the leftover
+ * is at least 2^64 mod the product, which only needs checking at all when
+ * it's below the product itself, less than once in 65536 batches.
+ */
+static inline int batchsize(int64_t bound) {
+    if (bound <= 0x100) return 6;
+    if (bound <= 0x1000) return 4;
+    if (bound <= 0x10000) return 3;
+    if (bound <= 0x1000000) return 2;
+    return 1;
+}
+
+static inline void batch(ojr_generator *g, uint32_t bound, int n,
+int64_t *out) {
+    int j;
+    uint64_t r, p, t;
+
+    r = OJR_NEXT64(g);
+    for (j = 0; j < n; ++j) out[j] = mulshift(&r, bound - j);
+
+    if (r >= MAXPRODUCT) return;
+
+    for (p = 1, j = 0; j < n; ++j) p *= bound - j;
+    if (r < p) {
+        t = -p % p;
+        while (r < t) {
+            r = OJR_NEXT64(g);
+            for (j = 0; j < n; ++j) out[j] = mulshift(&r, bound - j);
+        }
+    }
+}
+
+/* Fill <out> with the <n> swap targets of a Fisher-Yates shuffle of <nmemb>
+ * elements starting at step <start>, so that element start+k is swapped
+ * with out[k]. Used by the C++ shuffles, so they give the same permutation
+ * as ojr_shuffle().
+ */
+static inline void targets(ojr_generator *g, int64_t nmemb, int64_t start,
+int64_t *out, int n) {
+    int j, k, b;
+    int64_t left;
+
+    for (k = 0; k < n; k += b) {
+        left = nmemb - start - k;
+        b = batchsize(left);
+        if (1 == b) {
+            out[k] = start + k + index64(g, left);
+            continue;
+        }
+        if (b > n - k) b = n - k;
+        if (b > left) b = (int)left;
+
+        batch(g, (uint32_t)left, b, out + k);
+        for (j = 0; j < b; ++j) out[k + j] += start + k + j;
+    }
+}
+
+void ojr_shuffle_targets(ojr_generator *g, int64_t nmemb, int64_t start,
+int64_t *out, int n) {
+    assert(start >= 0 && start + n <= nmemb);
+    targets(g, nmemb, start, out, n);
+}
+
+/* Swap targets are chosen a batch ahead and prefetched, so on arrays bigger
+ * than the cache the misses overlap instead of coming one per swap.
+ */
+static inline void shuffleloop(ojr_generator *g, char *a, int64_t nmemb,
+size_t size, int64_t count) {
+    int k, n;
+    int64_t i, r[OJR_SHUFFLE_BATCH];
+
+    for (i = 0; i < count; i += n) {
+        n = (count - i < OJR_SHUFFLE_BATCH) ? (int)(count - i) :
+            OJR_SHUFFLE_BATCH;
+        targets(g, nmemb, i, r, n);
+        for (k = 0; k < n; ++k) {
+            PREFETCH(a + r[k] * size);
+            PREFETCH(a + r[k] * size + size - 1);
+        }
+        for (k = 0; k < n; ++k) {
+            if (r[k] != i + k) swap(a + (i + k) * size, a + r[k] * size, size);
+        }
+    }
+}
+
+/* Move to the top of the array at <base> a random combination of <count> of
+ * its <nmemb> elements of <size> bytes, in random order, as the int and
+ * pointer array versions do.
+ */
+void ojr_shuffle(ojr_generator *g, void *base, int64_t nmemb, size_t size,
+int64_t count) {
+    assert(0x5eed1e55 == g->init);
+    assert(nmemb >= 0 && count >= 0 && count <= nmemb && size > 0);
+    if (nmemb < 2) return;
+    if (count == nmemb) --count;
+
+    // Constant sizes for the common cases, so swaps compile to moves
+    if (4 == size) shuffleloop(g, base, nmemb, 4, count);
+    else if (8 == size) shuffleloop(g, base, nmemb, 8, count);
+    else shuffleloop(g, base, nmemb, size, count);
+}
+
+/* Dealing from decks of up to 64 cards. The deck is a one-cache-line
+ * array of card numbers, partially shuffled with the same batched indices
+ * as the shuffles above, and each hand comes out as a mask with bit n set
+ * for card n. That is about twice as fast as selecting the n-th remaining
+ * bit of a mask of cards left.
+ */
+static const unsigned char newdeck[64] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63
+};
+
+static inline void deal(ojr_generator *g, int decksize, const int *sizes,
+int nhands, int total, uint64_t *out) {
+    int h, c, r, k = 0, n = 0, t = 0;
+    int64_t idx[6];
+    unsigned char deck[64], card;
+    uint64_t hand;
+
+    memcpy(deck, newdeck, sizeof(deck));
+    for (h = 0; h < nhands; ++h) {
+        hand = 0;
+        for (c = 0; c < sizes[h]; ++c, ++t) {
+            if (k == n) {
+                n = batchsize(decksize - t);
+                if (n > total - t) n = total - t;
+                batch(g, decksize - t, n, idx);
+                k = 0;
+            }
+            r = t + (int)idx[k++];
+            card = deck[r];
+            deck[r] = deck[t];
+            hand |= 1ULL << card;
+        }
+        out[h] = hand;
+    }
+}
+
+static int dealt(int decksize, const int *sizes, int nhands) {
+    int h, total = 0;
+
+    assert(decksize > 0 && decksize <= 64 && nhands >= 0);
+    for (h = 0; h < nhands; ++h) {
+        assert(sizes[h] >= 0);
+        total += sizes[h];
+    }
+    assert(total <= decksize);
+    return total;
+}
+
+/* Deal <nhands> disjoint hands of <sizes> cards from a deck of <decksize>
+ * cards numbered 0 to decksize-1, into <out> as masks with bit n set for
+ * card n.
+ */
+void ojr_deal(ojr_generator *g, int decksize, const int *sizes, int nhands,
+uint64_t *out) {
+    deal(g, decksize, sizes, nhands, dealt(decksize, sizes, nhands), out);
+}
+
+// <count> independent deals, <nhands> masks apiece.
+void ojr_fill_deal(ojr_generator *g, int decksize, const int *sizes,
+int nhands, uint64_t *out, int count) {
+    int i, total = dealt(decksize, sizes, nhands);
+
+    for (i = 0; i < count; ++i) {
+        deal(g, decksize, sizes, nhands, total, out + (size_t)i * nhands);
+    }
+}
+
+// Inside-out Fisher-Yates, shuffling <src> into <dst> as it copies.
+static void insideout(ojr_generator *g, char *dst, const char *src,
+int64_t nmemb, size_t size) {
+    int64_t i, r;
+
+    for (i = 0; i < nmemb; ++i) {
+        r = index64(g, i + 1);
+        if (r != i) copy(dst + i * size, dst + r * size, size);
+        copy(dst + r * size, src + i * size, size);
+    }
+}
+
+/* Scatter into <nb> = 2^<shift> buckets in <tmp> and shuffle them there,
+ * using one generator from <gens> per thread.
+ */
+static void bucketshuffle(char *a, char *tmp, int64_t nmemb, size_t size,
+int nb, int shift, int nt, ojr_generator **gens, uint32_t *seeds,
+int64_t *counts, int64_t *starts) {
+    int i;
+    int64_t off, t;
+
+    // Count each chunk's elements going to each bucket...
+    PARALLEL_FOR
+    for (int c = 0; c < NCHUNKS; ++c) {
+        ojr_generator *cg = gens[THREADNUM()];
+        int64_t j, end = nmemb * (c + 1) / NCHUNKS;
+        int64_t *cc = counts + (size_t)c * nb;
+        labels lb = { 0, 0 };
+
+        ojr_array_seed(cg, seeds + c * SEEDWORDS, SEEDWORDS);
+        for (j = nmemb * c / NCHUNKS; j < end; ++j) {
+            ++cc[nextlabel(cg, &lb, shift)];
+        }
+    }
+    // ...turn counts into offsets, bucket by bucket...
+    for (off = 0, i = 0; i < nb; ++i) {
+        starts[i] = off;
+        for (int c = 0; c < NCHUNKS; ++c) {
+            t = counts[(size_t)c * nb + i];
+            counts[(size_t)c * nb + i] = off;
+            off += t;
+        }
+    }
+    starts[nb] = off;
+
+    // ...then replay each chunk's stream to scatter its elements.
+    PARALLEL_FOR
+    for (int c = 0; c < NCHUNKS; ++c) {
+        ojr_generator *cg = gens[THREADNUM()];
+        int64_t j, end = nmemb * (c + 1) / NCHUNKS;
+        int64_t *cc = counts + (size_t)c * nb;
+        labels lb = { 0, 0 };
+
+        ojr_array_seed(cg, seeds + c * SEEDWORDS, SEEDWORDS);
+        for (j = nmemb * c / NCHUNKS; j < end; ++j) {
+            copy(tmp + cc[nextlabel(cg, &lb, shift)]++ * size,
+                a + j * size, size);
+        }
+    }
+    PARALLEL_FOR
+    for (int b = 0; b < nb; ++b) {
+        ojr_generator *cg = gens[THREADNUM()];
+        int64_t n = starts[b + 1] - starts[b];
+
+        ojr_array_seed(cg, seeds + (NCHUNKS + b) * SEEDWORDS, SEEDWORDS);
+        insideout(cg, a + starts[b] * size, tmp + starts[b] * size, n, size);
+    }
+}
+
+/* Shuffle <nmemb> elements of <size> bytes at <base> using up to <threads>
+ * threads, or as many as OpenMP likes if <threads> is 0. Needs a copy of
+ * the array, and falls back to an ordinary shuffle if it can't get one.
+ */
+void ojr_parallel_shuffle(ojr_generator *g, void *base, int64_t nmemb,
+size_t size, int threads) {
+    int i = 0, nt, nb, shift, id;
+    int64_t *counts, *starts;
+    uint32_t *seeds;
+    ojr_generator **gens;
+    char *tmp;
+
+    assert(0x5eed1e55 == g->init);
+    assert(nmemb >= 0 && size > 0);
+    if (nmemb < 2) return;
+
+    for (nb = 1, shift = 0; nb < MAXBUCKETS &&
+        (uint64_t)nmemb * size / nb > BUCKETBYTES; ++shift) nb <<= 1;
+    if (1 == nb) {
+        ojr_shuffle(g, base, nmemb, size, nmemb);
+        return;
+    }
+#ifdef _OPENMP
+    nt = (threads > 0) ? threads : omp_get_max_threads();
+#else
+    nt = 1;
+#endif
+    tmp = malloc((size_t)nmemb * size);
+    counts = calloc((size_t)NCHUNKS * nb, sizeof(int64_t));
+    starts = malloc((nb + 1) * sizeof(int64_t));
+    seeds = malloc((NCHUNKS + nb) * SEEDWORDS * sizeof(uint32_t));
+    gens = calloc(nt, sizeof(ojr_generator *));
+
+    if (NULL != gens) {
+        id = ojr_get_algorithm(g);
+        for (i = 0; i < nt; ++i) {
+            if (NULL == (gens[i] = ojr_open(ojr_algorithm_name(id)))) break;
+        }
+    }
+    if (NULL == tmp || NULL == counts || NULL == starts || NULL == seeds ||
+        NULL == gens || i < nt) {
+        ojr_shuffle(g, base, nmemb, size, nmemb);
+    } else {
+        for (i = 0; i < (NCHUNKS + nb) * SEEDWORDS; ++i) {
+            seeds[i] = OJR_NEXT32(g);
+        }
+        bucketshuffle(base, tmp, nmemb, size, nb, shift, nt, gens, seeds,
+            counts, starts);
+    }
+    if (NULL != gens) {
+        for (i = 0; i < nt && NULL != gens[i]; ++i) ojr_close(gens[i]);
+    }
+    free(gens);
+    free(seeds);
+    free(starts);
+    free(counts);
+    free(tmp);
+}
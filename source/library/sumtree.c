@@ -0,0 +1,137 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Weighted choice with weights that change, using a sum tree: both updating
+ * a weight and choosing an index are O(log n).
+ *
+ * The tree is 8-ary and implicit, with node m's children at 8m+1 to 8m+8,
+ * and v[m-1] holding the sum of weights under node m (the root's is kept in
+ * <total>). That puts each node's eight children in one 64-byte aligned
+ * block, so each level of a descent or an update touches one cache line,
+ * and a million items need only seven levels. Parents are recomputed from
+ * their children rather than adjusted by differences, so rounding errors
+ * don't accumulate however many updates are made.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ojrandlib.h"
+
+#define FANOUT 8
+
+static inline double groupsum(const double *c) {
+    return ((c[0] + c[1]) + (c[2] + c[3])) + ((c[4] + c[5]) + (c[6] + c[7]));
+}
+
+/* Create tree for <count> items with initial <weights>, or all zero if
+ * <weights> is NULL. Returns NULL on allocation failure.
+ */
+ojr_sumtree *ojr_sumtree_new(double *weights, int count) {
+    int i;
+    int64_t m, leaves, last;
+    ojr_sumtree *tp;
+    char *p;
+
+    assert(count > 0 && count <= 0x40000000);
+    if (NULL == (tp = malloc(sizeof(ojr_sumtree)))) return NULL;
+
+    tp->count = count;
+    tp->height = 1;
+    for (leaves = FANOUT; leaves < count; leaves *= FANOUT) ++tp->height;
+    tp->first = (leaves - 1) / (FANOUT - 1);
+
+    // Only allocate through the group holding the last real leaf.
+    last = tp->first + count - 1;
+    tp->size = ((last - 1) / FANOUT + 1) * FANOUT;
+
+    if (NULL == (p = malloc(tp->size * sizeof(double) + 63))) {
+        free(tp);
+        return NULL;
+    }
+    tp->mem = p;
+    tp->v = (double *)(p + ((64 - ((uintptr_t)p & 63)) & 63));
+    memset(tp->v, 0, tp->size * sizeof(double));
+
+    if (weights) {
+        for (i = 0; i < count; ++i) {
+            assert(weights[i] >= 0.0);
+            tp->v[tp->first + i - 1] = weights[i];
+        }
+    }
+    for (m = tp->first - 1; m > 0; --m) {
+        if (FANOUT * m < tp->size) tp->v[m - 1] = groupsum(tp->v + FANOUT * m);
+    }
+    tp->total = groupsum(tp->v);
+    return tp;
+}
+
+void ojr_sumtree_free(ojr_sumtree *tp) {
+    assert(NULL != tp);
+    free(tp->mem);
+    free(tp);
+}
+
+void ojr_sumtree_update(ojr_sumtree *tp, int index, double weight) {
+    int64_t m;
+    assert(index >= 0 && index < tp->count && weight >= 0.0);
+
+    m = tp->first + index;
+    tp->v[m - 1] = weight;
+    for (m = (m - 1) / FANOUT; m > 0; m = (m - 1) / FANOUT) {
+        tp->v[m - 1] = groupsum(tp->v + FANOUT * m);
+    }
+    tp->total = groupsum(tp->v);
+}
+
+double ojr_sumtree_weight(ojr_sumtree *tp, int index) {
+    assert(index >= 0 && index < tp->count);
+    return tp->v[tp->first + index - 1];
+}
+
+double ojr_sumtree_total(ojr_sumtree *tp) {
+    return tp->total;
+}
+
+/* Descend from the root, at each level choosing the child whose range of
+ * cumulative weight contains <u>. If rounding puts us past the end or on a
+ * zero-weight child, take the last positive one instead.
+ */
+static inline int sumtree(ojr_generator *g, const ojr_sumtree *tp) {
+    int j, k, h;
+    int64_t m = 0;
+    const double *c;
+    double u;
+
+    if (! (tp->total > 0.0)) return -1;
+    u = ojr_next_double(g) * tp->total;
+
+    for (h = 0; h < tp->height; ++h) {
+        c = tp->v + FANOUT * m;
+        k = -1;
+        for (j = 0; j < FANOUT - 1; ++j) {
+            if (c[j] > 0.0) k = j;
+            if (u < c[j]) break;
+            u -= c[j];
+        }
+        if (c[j] > 0.0) k = j;
+        m = FANOUT * m + 1 + k;
+    }
+    return (int)(m - tp->first);
+}
+
+// Return index with probability proportional to its weight, or -1 if all
+// weights are zero.
+int ojr_next_sumtree(ojr_generator *g, ojr_sumtree *tp) {
+    return sumtree(g, tp);
+}
+
+void ojr_fill_sumtree(ojr_generator *g, ojr_sumtree *tp, int *a, int count) {
+    int i;
+    for (i = 0; i < count; ++i) a[i] = sumtree(g, tp);
+}
@@ -9,6 +9,7 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <stdexcept>
 
 #include "ojrandlib.h"
 
@@ -54,17 +55,48 @@ Generator::Generator(const char *name) {
 }
 Generator::Generator() { Generator::_init(1); }
 
+// Copy of <g>, state, buffer position and all.
+Generator::Generator(const ojr_generator *g) {
+    this->cg = new ojr_generator;
+    *this->cg = *g;
+    this->cg->next = NULL;
+    this->cg->state = new uint32_t[g->statesize];
+    this->cg->buf = new uint32_t[g->bufsize];
+    this->cg->bptr = this->cg->buf + (g->bptr - g->buf);
+
+    std::memcpy(this->cg->state, g->state, g->statesize * sizeof(uint32_t));
+    std::memcpy(this->cg->buf, g->buf, g->bufsize * sizeof(uint32_t));
+}
+
 Generator::~Generator() {
+    if (NULL == this->cg) return;
     ojr_call_close(this->cg);
-    delete this->cg->buf;
-    delete this->cg->state;
+    delete[] this->cg->buf;
+    delete[] this->cg->state;
     delete this->cg;
 }
 
-void Generator::seed(Seed v) { ojr_array_seed(this->cg, v.data(), v.size()); }
+Generator::Generator(Generator &&g) noexcept : cg(g.cg) { g.cg = NULL; }
+
+Generator &Generator::operator=(Generator &&g) noexcept {
+    Generator old(std::move(g));
+    std::swap(this->cg, old.cg);
+    return *this;
+}
+
+Generator Generator::clone() const { return Generator(this->cg); }
+
+void Generator::seed(const Seed &v) { this->seed(v.data(), v.size()); }
+void Generator::seed(const uint32_t *s, int size) {
+    ojr_array_seed(this->cg, const_cast<uint32_t *>(s), size);
+}
 void Generator::seed(int val) { ojr_int_seed(this->cg, val); }
 void Generator::seed() { ojr_system_seed(this->cg); }
-void Generator::reseed(Seed v) { ojr_reseed(this->cg, v.data(), v.size()); }
+
+void Generator::reseed(const Seed &v) { this->reseed(v.data(), v.size()); }
+void Generator::reseed(const uint32_t *s, int size) {
+    ojr_reseed(this->cg, const_cast<uint32_t *>(s), size);
+}
 
 uint16_t Generator::next16() { return ojr_next16(this->cg); }
 uint32_t Generator::next32() { return ojr_next32(this->cg); }
@@ -78,4 +110,43 @@ double Generator::nextExponential() { return ojr_next_exponential(this->cg); }
 int Generator::rand(int limit) { return ojr_rand(this->cg, limit); }
 void Generator::discard(int count) { ojr_discard(this->cg, count); }
 
+void Generator::fillDouble(double *a, int count) {
+    ojr_fill_double(this->cg, a, count);
+}
+void Generator::fillNormal(double *a, int count) {
+    ojr_fill_normal(this->cg, a, count);
+}
+void Generator::fillExponential(double *a, int count) {
+    ojr_fill_exponential(this->cg, a, count);
+}
+void Generator::fillRand(uint32_t limit, uint32_t *a, int count) {
+    ojr_fill_rand32(this->cg, limit, a, count);
+}
+
+int Generator::setNormalLayers(int n) {
+    return ojr_set_normal_layers(this->cg, n);
+}
+int Generator::setExponentialLayers(int n) {
+    return ojr_set_exponential_layers(this->cg, n);
+}
+
+Alias::Alias(const std::vector<double> &weights) {
+    this->ca = weights.empty() ? NULL :
+        ojr_alias_new(const_cast<double *>(&weights[0]), weights.size());
+    if (NULL == this->ca) throw std::invalid_argument("oj::Alias: bad weights");
+}
+
+Alias::~Alias() { ojr_alias_free(this->ca); }
+
+int Alias::size() const { return this->ca->count; }
+int Alias::next() { return ojr_next_alias(DEFGEN, this->ca); }
+int Alias::next(Generator &g) { return ojr_next_alias(g.cg, this->ca); }
+
+void Alias::fill(std::vector<int> &v) {
+    if (! v.empty()) ojr_fill_alias(DEFGEN, this->ca, &v[0], v.size());
+}
+void Alias::fill(Generator &g, std::vector<int> &v) {
+    if (! v.empty()) ojr_fill_alias(g.cg, this->ca, &v[0], v.size());
+}
+
 } /* namespace */
@@ -0,0 +1,174 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Construction of ziggurat tables. This is used both at runtime for
+ * generators that ask for non-default layer counts, and at build time by
+ * mkzigtables to produce the default tables in zigtables.h, so it must not
+ * depend on anything else in the library.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "ojrandlib.h"
+
+#define SQRTHALFPI 1.2533141373155002512
+#define ISQ2 0.70710678118654752444
+
+struct zspec {
+    double (*f)(double, void *);
+    double (*finv)(double, void *);
+    double (*tail)(double, void *);
+    void *arg;
+};
+
+/* If we aren't given the tail area, integrate numerically with adaptive
+ * Simpson's rule after substituting x = r + t/(1-t), which maps [r, inf)
+ * onto [0, 1). That's fine for anything decaying at least as fast as 1/x^2.
+ */
+static double tailf(struct zspec *zs, double r, double t) {
+    if (t > 1.0 - 1e-12) t = 1.0 - 1e-12;
+    return (*zs->f)(r + t / (1.0 - t), zs->arg) / ((1.0 - t) * (1.0 - t));
+}
+
+static double simpson(struct zspec *zs, double r, double a, double b,
+double fa, double fm, double fb, double whole, double eps, int depth) {
+    double m = 0.5 * (a + b), lm = 0.5 * (a + m), rm = 0.5 * (m + b);
+    double flm = tailf(zs, r, lm), frm = tailf(zs, r, rm);
+    double left = (m - a) * (fa + 4.0 * flm + fm) / 6.0;
+    double right = (b - m) * (fm + 4.0 * frm + fb) / 6.0;
+    double d = left + right - whole;
+
+    if (depth <= 0 || fabs(d) <= 15.0 * eps) return left + right + d / 15.0;
+    return simpson(zs, r, a, m, fa, flm, fm, left, 0.5 * eps, depth - 1) +
+        simpson(zs, r, m, b, fm, frm, fb, right, 0.5 * eps, depth - 1);
+}
+
+static double tailarea(struct zspec *zs, double r) {
+    double fa, fm, fb;
+
+    if (zs->tail) return (*zs->tail)(r, zs->arg);
+    fa = tailf(zs, r, 0.0);
+    fm = tailf(zs, r, 0.5);
+    fb = tailf(zs, r, 1.0);
+    return simpson(zs, r, 0.0, 1.0, fa, fm, fb, (fa + 4.0 * fm + fb) / 6.0,
+        1e-14 * (fa + fm + fb), 40);
+}
+
+/* Walk up the ziggurat from the tail for a given <r>, storing x values in
+ * <x> if it isn't NULL. Returns how far the top of the last layer misses
+ * f(0): positive means the layers are too fat (r is too small), negative
+ * means they are too thin.
+ */
+static double walk(struct zspec *zs, int layers, double r, double *v,
+double *x) {
+    int i;
+    double y, xi = r, f0 = (*zs->f)(0.0, zs->arg);
+
+    *v = r * (*zs->f)(r, zs->arg) + tailarea(zs, r);
+    if (x) x[1] = r;
+
+    for (i = 1; i < layers - 1; ++i) {
+        y = (*zs->f)(xi, zs->arg) + *v / xi;
+        if (y >= f0) return f0 + (layers - i);
+        xi = (*zs->finv)(y, zs->arg);
+        if (x) x[i + 1] = xi;
+    }
+    return (*zs->f)(xi, zs->arg) + *v / xi - f0;
+}
+
+/* Build tables for a ziggurat of <layers> layers (a power of 2 from 8 to
+ * 4096) over the monotone decreasing density <f> on [0, inf), given its
+ * inverse and the area of its tail beyond a point. <f> needn't be
+ * normalized, and if <tail> is NULL it is integrated numerically. Tables
+ * are allocated in one block; returns NULL on bad input or allocation
+ * failure.
+ */
+ojr_zigtable *ojr_zigtable_new(int layers,
+double (*f)(double, void *), double (*finv)(double, void *),
+double (*tail)(double, void *), void *arg) {
+    int i, shift;
+    double lo, hi, mid, v, d;
+    ojr_zigtable *zt;
+    char *p;
+    struct zspec zs;
+
+    for (shift = 3; shift <= 12; ++shift) if ((1 << shift) == layers) break;
+    if (shift > 12 || NULL == f || NULL == finv) return NULL;
+    zs.f = f;
+    zs.finv = finv;
+    zs.tail = tail;
+    zs.arg = arg;
+
+    // Find a bracket, then bisect until we run out of precision.
+    lo = hi = 1.0;
+    while (walk(&zs, layers, lo, &v, NULL) < 0.0) {
+        lo *= 0.5;
+        if (lo < 1e-10) return NULL;
+    }
+    while (walk(&zs, layers, hi, &v, NULL) > 0.0) {
+        hi *= 2.0;
+        if (hi > 1e10) return NULL;
+    }
+    for (i = 0; i < 200; ++i) {
+        mid = 0.5 * (lo + hi);
+        if (mid <= lo || mid >= hi) break;
+        d = walk(&zs, layers, mid, &v, NULL);
+        if (d > 0.0) lo = mid;
+        else hi = mid;
+    }
+    p = malloc(sizeof(ojr_zigtable) +
+        (layers + 1) * 2 * sizeof(double) +
+        layers * (sizeof(uint64_t) + sizeof(double)));
+    if (NULL == p) return NULL;
+
+    zt = (ojr_zigtable *)p;
+    zt->layers = layers;
+    zt->shift = shift;
+    zt->ri = (uint64_t *)(p + sizeof(ojr_zigtable));
+    zt->rd = (double *)(zt->ri + layers);
+    zt->x = zt->rd + layers;
+    zt->f = zt->x + layers + 1;
+
+    zt->r = lo;
+    walk(&zs, layers, lo, &zt->v, zt->x);
+    zt->x[0] = zt->v / (*f)(lo, arg);
+    zt->x[layers] = 0.0;
+
+    for (i = 0; i <= layers; ++i) zt->f[i] = (*f)(zt->x[i], arg);
+    for (i = 0; i < layers; ++i) {
+        zt->rd[i] = zt->x[i + 1] / zt->x[i];
+        zt->ri[i] = (uint64_t)(zt->rd[i] * 4503599627370496.0);
+    }
+    return zt;
+}
+
+void ojr_zigtable_free(ojr_zigtable *zt) {
+    free(zt);
+}
+
+// Unnormalized half-normal and exponential densities.
+
+static double nf(double x, void *a) { return exp(-0.5 * x * x); }
+static double nfinv(double y, void *a) { return sqrt(-2.0 * log(y)); }
+static double ntail(double r, void *a) {
+    return SQRTHALFPI * erfc(r * ISQ2);
+}
+
+static double ef(double x, void *a) { return exp(-x); }
+static double efinv(double y, void *a) { return -log(y); }
+static double etail(double r, void *a) { return exp(-r); }
+
+ojr_zigtable *ojr_zigtable_normal(int layers) {
+    return ojr_zigtable_new(layers, nf, nfinv, ntail, NULL);
+}
+
+ojr_zigtable *ojr_zigtable_exponential(int layers) {
+    return ojr_zigtable_new(layers, ef, efinv, etail, NULL);
+}
@@ -21,93 +21,293 @@
 // On some (32-bit) machines, comparison of doubles might actually be
 // faster than 64-bit integer compares, so comment out this define
 #define INTEGER_COMPARE 1
+
+/* The default tables are built by mkzigtables at build time; the sizes of
+ * 128 and 256 from GM's paper are good, but "make ZIGNORMAL=1024" and the
+ * like will build with others. Generators can also select other layer
+ * counts at runtime, in which case tables are built on first use by
+ * zigbuild.c and shared among all generators.
+ */
 #include "zigtables.h"
 
-// The sizes of 128 and 256 from GM's paper are good, but I recalculated
-// the constants here and built fixed tables based on them.
+#ifdef INTEGER_COMPARE
+#  define ZRI(p) (p##ri)
+#  define ZRD(p) NULL
+#else
+#  define ZRI(p) NULL
+#  define ZRD(p) (p##r)
+#endif
 
-#define ZNR128 3.4426198558966521214
-#define ZNV128 0.0099125630353364610791
-#define ZER256 7.6971174701310497140
-#define ZEV256 0.0039496598225815572200
+static ojr_zigtable zndefault = {
+    ZNLAYERS, ZNSHIFT, ZNR, ZNV, ZRI(zn), ZRD(zn), znx, znf
+};
+static ojr_zigtable zedefault = {
+    ZELAYERS, ZESHIFT, ZER, ZEV, ZRI(ze), ZRD(ze), zex, zef
+};
 
-double ojr_next_exponential(ojr_generator *g) {
+/* Runtime-built tables, indexed by shift. Each is built on first use and
+ * published by compare-and-swap, so threads may set layers at the same
+ * time: if two build the same table, the one that loses the swap frees
+ * its copy and uses the winner's, which is complete by then.
+ */
+static ojr_zigtable *zncache[13], *zecache[13];
+
+static ojr_zigtable *cached(ojr_zigtable **cache, int layers, int normal) {
+    int shift;
+    ojr_zigtable *zt, *expected = NULL;
+
+    for (shift = 3; shift <= 12; ++shift) if ((1 << shift) == layers) break;
+    if (shift > 12) return NULL;
+
+    zt = __atomic_load_n(cache + shift, __ATOMIC_ACQUIRE);
+    if (NULL != zt) return zt;
+
+    zt = normal ?
+        ojr_zigtable_normal(layers) : ojr_zigtable_exponential(layers);
+    if (NULL == zt) return NULL;
+    if (! __atomic_compare_exchange_n(cache + shift, &expected, zt, 0,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        ojr_zigtable_free(zt);
+        zt = expected;
+    }
+    return zt;
+}
+
+/* Select the number of ziggurat layers used by this generator. Returns 0 on
+ * success, or -1 if <layers> isn't a power of 2 from 8 to 4096 or the
+ * tables couldn't be allocated. Building new tables takes a moment, so do
+ * this at setup time.
+ */
+int ojr_set_normal_layers(ojr_generator *g, int layers) {
+    ojr_zigtable *zt = NULL;
+    assert(0x5eed1e55 == g->init);
+
+    if (layers != ZNLAYERS) {
+        zt = cached(zncache, layers, 1);
+        if (NULL == zt) return -1;
+    }
+    g->znormal = zt;
+    return 0;
+}
+
+int ojr_get_normal_layers(ojr_generator *g) {
+    assert(0x5eed1e55 == g->init);
+    return g->znormal ? g->znormal->layers : ZNLAYERS;
+}
+
+int ojr_set_exponential_layers(ojr_generator *g, int layers) {
+    ojr_zigtable *zt = NULL;
+    assert(0x5eed1e55 == g->init);
+
+    if (layers != ZELAYERS) {
+        zt = cached(zecache, layers, 0);
+        if (NULL == zt) return -1;
+    }
+    g->zexp = zt;
+    return 0;
+}
+
+int ojr_get_exponential_layers(ojr_generator *g) {
+    assert(0x5eed1e55 == g->init);
+    return g->zexp ? g->zexp->layers : ZELAYERS;
+}
+
+// Called at library shutdown, after all generators are gone.
+void ojr_zigtable_release_all(void) {
+    int i;
+
+    for (i = 0; i < 13; ++i) {
+        if (zncache[i]) ojr_zigtable_free(zncache[i]);
+        if (zecache[i]) ojr_zigtable_free(zecache[i]);
+        zncache[i] = zecache[i] = NULL;
+    }
+}
+
+/* Core sampling loops, shared by the built-in distributions and by user-
+ * defined ziggurats. <f> is only called in the wedges and <tail> only for
+ * the base layer, so passing them as pointers costs little, and for the
+ * built-in ones they are constants the compiler can inline anyway.
+ *
+ * The one-sided loop takes the layer index from the low <shift> bits and
+ * the mantissa from the next 52.
+ */
+static inline double onesided(ojr_generator *g, const ojr_zigtable *zt,
+double (*f)(double, void *),
+double (*tail)(ojr_generator *, double, void *), void *arg) {
     uint64_t r;
     int i;
-    double x, u0, f0, f1;
+    double x, u0;
+    const double *zx = zt->x;
+    int mask = zt->layers - 1, shift = zt->shift;
 
     while (1) {
         r = OJR_NEXT64(g);
-        i = r & 0xFF;
-        r = (r >> 8) & 0xFFFFFFFFFFFFFULL;
+        i = r & mask;
+        r = (r >> shift) & 0xFFFFFFFFFFFFFULL;
 
 #ifdef INTEGER_COMPARE
-        if (r < zeri[i]) {
+        if (r < zt->ri[i]) {
             r |= 0x3FF0000000000000ULL;
             u0 = *(double *)(&r) - 1.0;
-            return u0 * zex[i];
+            return u0 * zx[i];
         }
 #else
         r |= 0x3FF0000000000000ULL;
         u0 = *(double *)(&r) - 1.0;
 
-        if (u0 < zer[i]) return u0 * zex[i];
+        if (u0 < zt->rd[i]) return u0 * zx[i];
 #endif
-        if (0 == i) return ZER256 - log(ojr_next_double(g));
+        if (0 == i) return (*tail)(g, zt->r, arg);
 
 #ifdef INTEGER_COMPARE
         r |= 0x3FF0000000000000ULL;
         u0 = *(double *)(&r) - 1.0;
 #endif
-        x = u0 * zex[i];
-        f0 = exp(x - zex[i]);
-        f1 = exp(x - zex[i+1]);
-        if (f1 + ojr_next_double(g) * (f0 - f1) < 1.0) return x;
+        x = u0 * zx[i];
+        if (zt->f[i+1] + ojr_next_double(g) * (zt->f[i] - zt->f[i+1]) <
+            (*f)(x, arg)) return x;
     }
 }
 
-double ojr_next_normal(ojr_generator *g) {
+/* For symmetric densities the sign takes the low bit and the layer index the
+ * next <shift> bits, leaving the top 52 bits for the mantissa. With 4096
+ * layers that's one bit short, so we use 51 bits and shift them back up.
+ */
+static inline double symmetric(ojr_generator *g, const ojr_zigtable *zt,
+double (*f)(double, void *),
+double (*tail)(ojr_generator *, double, void *), void *arg) {
     uint64_t r;
     int i, sign;
-    double x, y, a, u0, f0, f1;
+    double x, a;
+    const double *zx = zt->x;
+    int mask = zt->layers - 1, rs = zt->shift + 1, ls = 0;
+
+    if (rs < 12) rs = 12;
+    else ls = rs - 12;
 
     while (1) {
         do {
             r = OJR_NEXT64(g);
             sign = (int)r & 1;
-            i = (r >> 1) & 0x7F;
-            r >>= 12;
+            i = (r >> 1) & mask;
+            r = (r >> rs) << ls;
         } while (sign && 0LL == r);
 
 #ifdef INTEGER_COMPARE
-        if (r < znri[i]) {
+        if (r < zt->ri[i]) {
             r |= 0x3FF0000000000000ULL;
             a = *(double *)(&r) - 1.0;
-            return znx[i] * (sign ? -a : a);
+            return zx[i] * (sign ? -a : a);
         }
-#else
+#endif
         r |= 0x3FF0000000000000ULL;
         a = *(double *)(&r) - 1.0;
-        u0 = sign ? -a : a;
-
-        if (a < znr[i]) return u0 * znx[i];
+#ifndef INTEGER_COMPARE
+        if (a < zt->rd[i]) return zx[i] * (sign ? -a : a);
 #endif
         if (0 == i) {
-            do {
-                x = log(ojr_next_double(g)) / ZNR128;
-                y = log(ojr_next_double(g));
-            } while (-2.0 * y < x * x);
-            return sign ? x - ZNR128 : ZNR128 - x;
+            x = (*tail)(g, zt->r, arg);
+            return sign ? -x : x;
+        }
+        x = zx[i] * a;
+        if (zt->f[i+1] + ojr_next_double(g) * (zt->f[i] - zt->f[i+1]) <
+            (*f)(x, arg)) return sign ? -x : x;
+    }
+}
+
+static inline double ef(double x, void *arg) { return exp(-x); }
+static inline double nf(double x, void *arg) { return exp(-0.5 * x * x); }
+
+static inline double etail(ojr_generator *g, double r, void *arg) {
+    return r - log(ojr_next_double(g));
+}
+
+static inline double ntail(ojr_generator *g, double r, void *arg) {
+    double x, y;
+
+    do {
+        x = log(ojr_next_double(g)) / r;
+        y = log(ojr_next_double(g));
+    } while (-2.0 * y < x * x);
+    return r - x;
+}
+
+double ojr_next_exponential(ojr_generator *g) {
+    return onesided(g, g->zexp ? g->zexp : &zedefault, ef, etail, NULL);
+}
+
+double ojr_next_normal(ojr_generator *g) {
+    return symmetric(g, g->znormal ? g->znormal : &zndefault, nf, ntail, NULL);
+}
+
+// Fill an array with <count> values. Same stream as repeated calls.
+
+void ojr_fill_exponential(ojr_generator *g, double *a, int count) {
+    int i;
+    const ojr_zigtable *zt = g->zexp ? g->zexp : &zedefault;
+
+    for (i = 0; i < count; ++i) a[i] = onesided(g, zt, ef, etail, NULL);
+}
+
+void ojr_fill_normal(ojr_generator *g, double *a, int count) {
+    int i;
+    const ojr_zigtable *zt = g->znormal ? g->znormal : &zndefault;
+
+    for (i = 0; i < count; ++i) a[i] = symmetric(g, zt, nf, ntail, NULL);
+}
+
+/* User-defined ziggurats. <f> is a monotone decreasing density on [0, inf)
+ * (or the right half of a symmetric one if <sym> is nonzero), <finv> is its
+ * inverse, <area> returns the area of the tail beyond a given point (or is
+ * NULL to integrate numerically), and <tail> samples from that tail. None
+ * need be normalized, but all must agree. Returns NULL on bad arguments or
+ * allocation failure.
+ */
+ojr_ziggurat *ojr_ziggurat_new(int layers, int sym,
+double (*f)(double, void *), double (*finv)(double, void *),
+double (*area)(double, void *),
+double (*tail)(ojr_generator *, double, void *), void *arg) {
+    ojr_ziggurat *z;
+
+    if (NULL == tail) return NULL;
+    if (NULL == (z = malloc(sizeof(ojr_ziggurat)))) return NULL;
+
+    z->table = ojr_zigtable_new(layers, f, finv, area, arg);
+    if (NULL == z->table) {
+        free(z);
+        return NULL;
+    }
+    z->density = f;
+    z->tail = tail;
+    z->arg = arg;
+    z->symmetric = sym;
+    return z;
+}
+
+void ojr_ziggurat_free(ojr_ziggurat *z) {
+    assert(NULL != z);
+    ojr_zigtable_free(z->table);
+    free(z);
+}
+
+double ojr_next_ziggurat(ojr_generator *g, ojr_ziggurat *z) {
+    if (z->symmetric) {
+        return symmetric(g, z->table, z->density, z->tail, z->arg);
+    }
+    return onesided(g, z->table, z->density, z->tail, z->arg);
+}
+
+void ojr_fill_ziggurat(ojr_generator *g, ojr_ziggurat *z, double *a,
+int count) {
+    int i;
+
+    if (z->symmetric) {
+        for (i = 0; i < count; ++i) {
+            a[i] = symmetric(g, z->table, z->density, z->tail, z->arg);
+        }
+    } else {
+        for (i = 0; i < count; ++i) {
+            a[i] = onesided(g, z->table, z->density, z->tail, z->arg);
         }
-#ifdef INTEGER_COMPARE
-        r |= 0x3FF0000000000000ULL;
-        a = *(double *)(&r) - 1.0;
-        x = znx[i] * (sign ? -a : a);
-#else
-        x = u0 * znx[i];
-#endif
-        f0 = exp(-0.5 * (znx[i] * znx[i] - x * x));
-        f1 = exp(-0.5 * (znx[i+1] * znx[i+1] - x * x));
-        if (f1 + ojr_next_double(g) * (f0 - f1) < 1.0) return x;
     }
 }
@@ -3,10 +3,15 @@
 # Main python module.
 #
 
-import sys, os
+import sys, os, array, threading, random, hashlib, itertools
 from ctypes import *
 from ctypes.util import find_library
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 # Work around bug in Windows Python3
 if "nt" == os.name:
     _lib = CDLL(find_library("ojrand.dll"))
@@ -22,6 +27,30 @@ _lib.ojr_next_signed_double.restype = c_double
 _lib.ojr_next_normal.restype = c_double
 _lib.ojr_next_exponential.restype = c_double
 
+# Bulk fills take a pointer and a count of at most this many values
+_FILLMAX = 1 << 30
+
+def _fill(fn, gen, buf, size):
+    """Fill writable buffer <buf> with values of <size> bytes by calling
+    <fn> once per billion or so, rather than once per value.
+    """
+    m = memoryview(buf)
+    if m.readonly:
+        raise TypeError("buffer is not writable")
+    if not m.c_contiguous:
+        raise ValueError("buffer is not contiguous")
+    count = m.nbytes // size
+    if 0 == count:
+        return buf
+
+    c = (c_char * m.nbytes).from_buffer(m)
+    base = addressof(c)
+    for i in range(0, count, _FILLMAX):
+        fn(gen, c_void_p(base + i * size), min(count - i, _FILLMAX))
+    del c
+    m.release()
+    return buf
+
 def algorithms():
     for i in range(_lib.ojr_algorithm_count()):
         yield _lib.ojr_algorithm_name(i + 1).decode()
@@ -88,10 +117,10 @@ class Generator(object):
                 seed = (c_int32 * size)(*s)
             else:
                 size = 1
-                seed = (c_int32 * size)([s])
+                seed = (c_int32 * size)(s)
 
-        _lib.ojr_call_seed(self.gen, seed, size)
-        _lib.ojr_set_seeded(self.gen, 1)
+        # This also empties the buffer, so the seed alone fixes the stream
+        _lib.ojr_array_seed(self.gen, seed, size)
 
     def reseed(self):
         size = algorithm_seedsize(_lib.ojr_get_algorithm(self.gen))
@@ -125,3 +154,207 @@ class Generator(object):
 
     def rand(self, limit):
         return _lib.ojr_rand(self.gen, limit)
+
+    # Bulk versions: fill any writable buffer (bytearray, memoryview,
+    # array.array, numpy array...) in one C call, as many values as fit.
+
+    def fill32(self, buf):
+        return _fill(_lib.ojr_fill32, self.gen, buf, 4)
+
+    def fill64(self, buf):
+        return _fill(_lib.ojr_fill64, self.gen, buf, 8)
+
+    def fill_double(self, buf):
+        return _fill(_lib.ojr_fill_double, self.gen, buf, 8)
+
+    def fill_normal(self, buf):
+        return _fill(_lib.ojr_fill_normal, self.gen, buf, 8)
+
+    # New arrays of <count> values: numpy arrays if there's numpy, else
+    # array.array.
+
+    def _array(self, fill, count, dtype, code):
+        if numpy is not None:
+            a = numpy.empty(count, dtype)
+        else:
+            a = array.array(code, [0]) * count
+        return fill(a)
+
+    def array32(self, count):
+        return self._array(self.fill32, count, "uint32", "I")
+
+    def array64(self, count):
+        return self._array(self.fill64, count, "uint64", "Q")
+
+    def array_double(self, count):
+        return self._array(self.fill_double, count, "float64", "d")
+
+    def array_normal(self, count):
+        return self._array(self.fill_normal, count, "float64", "d")
+
+
+# NumPy's bitgen_t: a state pointer and the functions numpy.random calls
+# with it. The library's ojr_next64(), ojr_next32() and ojr_next_double()
+# take the generator as their only argument, so they serve as they are.
+class _bitgen_t(Structure):
+    _fields_ = [("state", c_void_p), ("next_uint64", c_void_p),
+                ("next_uint32", c_void_p), ("next_double", c_void_p),
+                ("next_raw", c_void_p)]
+
+_capsule_new = pythonapi.PyCapsule_New
+_capsule_new.restype = py_object
+_capsule_new.argtypes = [c_void_p, c_char_p, c_void_p]
+
+class BitGenerator(object):
+    """Bit generator for numpy.random.Generator, which draws straight from
+    the generator's buffer with no Python in between:
+
+        rng = numpy.random.Generator(ojrandlib.BitGenerator("mt19937", 42))
+
+    NumPy takes anything with a "BitGenerator" capsule and a lock, so this
+    needn't (and from Python, can't) subclass numpy.random.BitGenerator.
+    """
+    _name = b"BitGenerator"
+
+    def __init__(self, algorithm = "jkiss127", seed = None):
+        self.generator = Generator(algorithm)
+        if seed is not None:
+            self.generator.seed(seed)
+
+        self.lock = threading.Lock()
+        self._bitgen = _bitgen_t(addressof(self.generator.gen),
+            cast(_lib.ojr_next64, c_void_p).value,
+            cast(_lib.ojr_next32, c_void_p).value,
+            cast(_lib.ojr_next_double, c_void_p).value,
+            cast(_lib.ojr_next64, c_void_p).value)
+        self.capsule = _capsule_new(addressof(self._bitgen), self._name,
+            None)
+
+    def random_raw(self, size = None, output = True):
+        """Raw 64-bit words, as numpy.random.BitGenerator.random_raw().
+        With <output> false, draw them and return None.
+        """
+        with self.lock:
+            if size is None:
+                r = self.generator.next64() & 0xFFFFFFFFFFFFFFFF
+            else:
+                r = self.generator.array64(size)
+        return r if output else None
+
+def default_rng(algorithm = "jkiss127", seed = None):
+    """numpy.random.Generator on one of ours."""
+    if numpy is None:
+        raise ImportError("numpy is not available")
+    return numpy.random.Generator(BitGenerator(algorithm, seed))
+
+
+# array.array type code for 32-bit words
+_WORD = "I" if 4 == array.array("I").itemsize else "L"
+
+class OJRandom(random.Random):
+    """random.Random on our generators, for code that wants one. Each
+    thread gets its own generator, so threads don't contend for one, and
+    random(), getrandbits() and randbytes() are served from chunks filled
+    in bulk rather than a C call apiece. Everything else in random.Random
+    is built on those.
+
+    With a seed, each thread's generator is seeded from a SHA-512 hash of
+    that seed and the thread's number (in order of first draw), so no two
+    threads, under this seed or any other, share a stream. Without one,
+    each thread's generator is seeded from system entropy.
+    """
+    CHUNK = 1024
+
+    def __init__(self, x = None, algorithm = "jkiss127"):
+        self._algorithm = algorithm
+        super().__init__(x)
+
+    def seed(self, a = None, version = 2):
+        if a is None:
+            self._seedwords = None
+        else:
+            # Floats by their exact value, so 3.5 and 3 differ
+            if isinstance(a, float):
+                a = int(a) if a.is_integer() else a.hex()
+            if isinstance(a, str):
+                a = a.encode()
+            if isinstance(a, (bytes, bytearray)):
+                a = int.from_bytes(hashlib.sha512(a).digest(), "big")
+            elif not isinstance(a, int):
+                raise TypeError("seed must be None, int, float, str, bytes, "
+                    "or bytearray")
+            a = abs(a)
+            self._seedwords = [(a >> i) & 0xFFFFFFFF
+                for i in range(0, max(a.bit_length(), 1), 32)]
+        self._threads = itertools.count()
+        self._local = threading.local()
+        self.gauss_next = None
+
+    def getstate(self):
+        raise NotImplementedError("OJRandom state is per thread")
+
+    def setstate(self, state):
+        raise NotImplementedError("OJRandom state is per thread")
+
+    def _generator(self):
+        local = self._local
+        try:
+            return local.generator
+        except AttributeError:
+            pass
+        g = Generator(self._algorithm)
+        if self._seedwords is not None:
+            n = next(self._threads)
+            words = [len(self._seedwords)] + self._seedwords + [n]
+            h = hashlib.sha512(b"".join(w.to_bytes(8, "little")
+                for w in words)).digest()
+            g.seed([int.from_bytes(h[i:i + 4], "little")
+                for i in range(0, len(h), 4)])
+        local.generator = g
+        local.doubles = local.words = iter(())
+        local.bytes, local.bpos = b"", 0
+        return g
+
+    def random(self):
+        try:
+            return next(self._local.doubles)
+        except (AttributeError, StopIteration):
+            a = array.array("d", [0.0]) * self.CHUNK
+            self._generator().fill_double(a)
+            self._local.doubles = iter(a.tolist())
+            return next(self._local.doubles)
+
+    def _word(self):
+        try:
+            return next(self._local.words)
+        except (AttributeError, StopIteration):
+            a = array.array(_WORD, [0]) * self.CHUNK
+            self._generator().fill32(a)
+            self._local.words = iter(a.tolist())
+            return next(self._local.words)
+
+    def getrandbits(self, k):
+        if k <= 32:
+            if k < 0:
+                raise ValueError("number of bits must be non-negative")
+            return self._word() >> (32 - k) if k else 0
+        n = (k + 31) // 32
+        return int.from_bytes(self.randbytes(4 * n), "little") >> (32 * n - k)
+
+    def randbytes(self, n):
+        if n <= 0:
+            return b""
+        self._generator()
+        local = self._local
+        if n > 4 * self.CHUNK:
+            b = bytearray((n + 3) & ~3)
+            local.generator.fill32(b)
+            return bytes(b[:n])
+
+        if local.bpos + n > len(local.bytes):
+            b = bytearray(4 * self.CHUNK)
+            local.generator.fill32(b)
+            local.bytes, local.bpos = bytes(b), 0
+        r = local.bytes[local.bpos:local.bpos + n]
+        local.bpos += n
+        return r
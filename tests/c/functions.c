@@ -39,6 +39,16 @@ static uint32_t arr16[3][16] = {
       0xeaba6612, 0xe1edccc4, 0xaca788df, 0xe23032fb },
 };
 
+/* Xor of the first million words after seeding with arr04, and the word
+ * after them, so changes to a refill that keep the first bufferful right
+ * are still caught.
+ */
+static uint32_t arr1m[3][2] = {
+    { 0xddf83110, 0x11b43e7c },
+    { 0x235c7332, 0x4c61d087 },
+    { 0x64e0ee95, 0x9be2bc56 },
+};
+
 int statics(void) {
     int i, j, c = ACOUNT;
     uint32_t v1, v2;
@@ -82,7 +92,8 @@ int structureaccess(void) {
         (gen.leftover != 0) || (gen.flags != 0) ||
         (gen.algorithm != 0) || (gen.statesize != 0) || (gen.bufsize != 0) ||
         (gen.state != NULL) || (gen.buf != NULL) || (gen.bptr != NULL) ||
-        (gen.next != NULL) || (gen.extra != NULL)) return 200;
+        (gen.next != NULL) || (gen.extra != NULL) ||
+        (gen.znormal != NULL) || (gen.zexp != NULL)) return 200;
 
     ojr_set_seeded(&gen, 1);
     if (1 != ojr_get_seeded(&gen)) return 210;
@@ -106,6 +117,13 @@ int structureaccess(void) {
     ojr_set_extra(&gen, (void *)6);
     if (ojr_get_extra(&gen) != (void *)6) return 240;
 
+    if (0 != ojr_set_normal_layers(&gen, 1024) ||
+        1024 != ojr_get_normal_layers(&gen)) return 245;
+    if (0 != ojr_set_exponential_layers(&gen, 4096) ||
+        4096 != ojr_get_exponential_layers(&gen)) return 246;
+    if (0 == ojr_set_normal_layers(&gen, 1000) ||
+        1024 != ojr_get_normal_layers(&gen)) return 247;
+
     return 0;
 }
 
@@ -151,6 +169,19 @@ int arrayseed(void) {
     return f;
 }
 
+int longstream(void) {
+    int i, f = 0, a = ojr_rand(DEFGEN, ACOUNT);
+    uint32_t x = 0;
+    ojr_generator *g = ojr_open(anames[a]);
+    ojr_array_seed(g, arr04[a], 4);
+
+    for (i = 0; i < 1000000; ++i) x ^= ojr_next32(g);
+    if (x != arr1m[a][0] || ojr_next32(g) != arr1m[a][1]) f = 45;
+
+    ojr_close(g);
+    return f;
+}
+
 int goodseed(void) {
     int i, f = 0, a = ojr_rand(DEFGEN, ACOUNT);
     uint32_t first[4], second[4];
@@ -214,6 +245,313 @@ int outoforder(void) {
     return f;
 }
 
+/* Parallel shuffles must give a permutation, and the same one whatever the
+ * number of threads.
+ */
+int shuffles(void) {
+    int i, f = 0, n = 300000 + ojr_rand(DEFGEN, 1000);
+    uint32_t seed[4];
+    int *a = malloc(n * sizeof(int)), *b = malloc(n * sizeof(int));
+    int64_t *c = malloc(n * sizeof(int64_t));
+    char *seen = calloc(n, 1);
+    ojr_generator *g = ojr_open(anames[ojr_rand(DEFGEN, ACOUNT)]);
+
+    ojr_get_system_entropy(seed, 4);
+    for (i = 0; i < n; ++i) a[i] = b[i] = c[i] = i;
+
+    ojr_array_seed(g, seed, 4);
+    ojr_parallel_shuffle(g, a, n, sizeof(int), 1);
+    ojr_array_seed(g, seed, 4);
+    ojr_parallel_shuffle(g, b, n, sizeof(int), 4);
+    ojr_array_seed(g, seed, 4);
+    ojr_parallel_shuffle(g, c, n, sizeof(int64_t), 0);
+
+    for (i = 0; i < n; ++i) {
+        if (a[i] < 0 || a[i] >= n || seen[a[i]]) f = 200;
+        else seen[a[i]] = 1;
+    }
+    if (0 != memcmp(a, b, n * sizeof(int))) f = 210;
+    for (i = 0; i < n; ++i) {
+        if (c[i] < 0 || c[i] >= n || 0 == seen[c[i]]) f = 220;
+        else seen[c[i]] = 0;
+    }
+
+    ojr_close(g);
+    free(seen);
+    free(c);
+    free(b);
+    free(a);
+    return f;
+}
+
+/* Batched swap targets must stay in range across the bounds where batch
+ * sizes change and across 2^32, and for a small array every sequence of
+ * targets from one batch must be equally likely (chi-square, 119 degrees
+ * of freedom, failing only far above the mean).
+ */
+static int64_t edges[] = { 0x100, 0x1000, 0x10000, 0x1000000, 0x100000000LL };
+
+int shuffletargets(void) {
+    int i, j, k, f = 0;
+    int64_t nmemb, start, out[40], counts[120];
+    double chi;
+
+    for (i = 0; i < 5; ++i) {
+        nmemb = edges[i] + 20 + ojr_rand(DEFGEN, 1000);
+        start = nmemb - edges[i] - ojr_rand(DEFGEN, 20);
+        ojr_shuffle_targets(DEFGEN, nmemb, start, out, 40);
+        for (k = 0; k < 40; ++k) {
+            if (out[k] < start + k || out[k] >= nmemb) f = 420;
+        }
+    }
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < 24000; ++i) {
+        ojr_shuffle_targets(DEFGEN, 5, 0, out, 4);
+        for (j = 0, k = 0; k < 4; ++k) {
+            if (out[k] < k || out[k] >= 5) return 430;
+            j = j * (5 - k) + (int)(out[k] - k);
+        }
+        ++counts[j];
+    }
+    for (chi = 0.0, j = 0; j < 120; ++j) {
+        chi += (counts[j] - 200.0) * (counts[j] - 200.0) / 200.0;
+    }
+    if (chi > 220.0) f = 440;
+    return f;
+}
+
+/* Generic shuffles of odd-sized records must keep each record intact, and
+ * partial ones must leave a permutation with the rest.
+ */
+struct rec12 { int v, check[2]; };
+
+int recordshuffle(void) {
+    int i, f = 0, n = 1 + ojr_rand(DEFGEN, 5000), k = ojr_rand(DEFGEN, n + 1);
+    struct rec12 *a = malloc(n * sizeof(struct rec12));
+    char *seen = calloc(n, 1);
+
+    for (i = 0; i < n; ++i) {
+        a[i].v = i;
+        a[i].check[0] = ~i;
+        a[i].check[1] = i * 7;
+    }
+    ojr_shuffle(DEFGEN, a, n, sizeof(struct rec12), k);
+
+    for (i = 0; i < n; ++i) {
+        if (a[i].v < 0 || a[i].v >= n || seen[a[i].v]) f = 230;
+        else seen[a[i].v] = 1;
+        if (a[i].check[0] != ~a[i].v || a[i].check[1] != a[i].v * 7) f = 240;
+    }
+    free(seen);
+    free(a);
+    return f;
+}
+
+// Hands must be disjoint, from the deck, and the right sizes.
+int deals(void) {
+    int i, j, k, bits, f = 0, nh = 1 + ojr_rand(DEFGEN, 10), sizes[10];
+    int deck = 1 + ojr_rand(DEFGEN, 64), left = deck;
+    uint64_t seen, out[10 * 20];
+
+    for (i = 0; i < nh; ++i) {
+        sizes[i] = ojr_rand(DEFGEN, left / nh + 1);
+        left -= sizes[i];
+    }
+    ojr_fill_deal(DEFGEN, deck, sizes, nh, out, 20);
+
+    for (k = 0; k < 20; ++k) {
+        seen = 0;
+        for (i = 0; i < nh; ++i) {
+            if (seen & out[k * nh + i]) f = 250;
+            seen |= out[k * nh + i];
+            for (bits = 0, j = 0; j < 64; ++j) {
+                if (out[k * nh + i] & (1ULL << j)) ++bits;
+            }
+            if (bits != sizes[i]) f = 260;
+        }
+        if (deck < 64 && (seen >> deck)) f = 270;
+    }
+    return f;
+}
+
+// Arrays with a given sum must have it, with no negative parts.
+int withsum(void) {
+    int i, k, f = 0, n = 1 + ojr_rand(DEFGEN, 100), a[100];
+    int sum = ojr_rand(DEFGEN, 2) ? ojr_rand(DEFGEN, 100) : 0x7FFFFFFF;
+    int64_t t, b[100 * 10], bigsum = 0x7FFFFFFFFFFFFFFFLL >> ojr_rand(DEFGEN, 60);
+
+    ojr_array_with_sum(DEFGEN, a, n, sum);
+    for (t = 0, i = 0; i < n; ++i) {
+        if (a[i] < 0) f = 280;
+        t += a[i];
+    }
+    if (t != sum) f = 290;
+
+    ojr_fill_array_with_sum64(DEFGEN, b, n, bigsum, 10);
+    for (k = 0; k < 10; ++k) {
+        for (t = 0, i = 0; i < n; ++i) {
+            if (b[k * n + i] < 0) f = 300;
+            t += b[k * n + i];
+        }
+        if (t != bigsum) f = 310;
+    }
+    return f;
+}
+
+// Samples must be distinct and in range, and sorted ones sorted.
+int samples(void) {
+    int i, j, f = 0;
+    int64_t n, k, out[300];
+
+    n = ojr_rand(DEFGEN, 2) ? 1 + ojr_rand(DEFGEN, 1000) :
+        (int64_t)(ojr_next64(DEFGEN) >> (1 + ojr_rand(DEFGEN, 40)));
+    k = ojr_rand(DEFGEN, (n < 300) ? (int)n + 1 : 300);
+
+    ojr_sample_indices(DEFGEN, n, k, out);
+    for (i = 0; i < k; ++i) {
+        if (out[i] < 0 || out[i] >= n) f = 320;
+        if (i > 0 && out[i] <= out[i - 1]) f = 330;
+    }
+    ojr_sample_indices_unsorted(DEFGEN, n, k, out);
+    for (i = 0; i < k; ++i) {
+        if (out[i] < 0 || out[i] >= n) f = 320;
+        for (j = 0; j < i; ++j) if (out[j] == out[i]) f = 340;
+    }
+    return f;
+}
+
+/* Gamma-family fills must give the same values as repeated calls, and tiny
+ * shapes, whose gammas underflow, must still give betas and Dirichlet
+ * vectors in range.
+ */
+static double gshapes[] = { 1e-3, 0.005, 0.3, 1.0, 2.5, 7.0 };
+#define GSHAPE() gshapes[ojr_rand(DEFGEN, sizeof(gshapes) / sizeof(double))]
+
+int gammas(void) {
+    int i, j, f = 0, k = 1 + ojr_rand(DEFGEN, 5);
+    double a = GSHAPE(), b = GSHAPE(), alpha[5], x[500], y[500], sum;
+    uint32_t seed[4];
+    ojr_generator *g1, *g2;
+
+    i = ojr_rand(DEFGEN, ACOUNT);
+    g1 = ojr_open(anames[i]);
+    g2 = ojr_open(anames[i]);
+    ojr_get_system_entropy(seed, 4);
+    ojr_array_seed(g1, seed, 4);
+    ojr_array_seed(g2, seed, 4);
+    for (i = 0; i < k; ++i) alpha[i] = GSHAPE();
+
+    ojr_fill_gamma(g1, a, 2.0, x, 100);
+    for (i = 0; i < 100; ++i) y[i] = ojr_next_gamma(g2, a, 2.0);
+    if (0 != memcmp(x, y, 100 * sizeof(double))) f = 450;
+
+    ojr_fill_chisquare(g1, 2.0 * b, x, 100);
+    for (i = 0; i < 100; ++i) y[i] = ojr_next_chisquare(g2, 2.0 * b);
+    if (0 != memcmp(x, y, 100 * sizeof(double))) f = 455;
+
+    ojr_fill_student_t(g1, 2.0 * a, x, 100);
+    for (i = 0; i < 100; ++i) y[i] = ojr_next_student_t(g2, 2.0 * a);
+    if (0 != memcmp(x, y, 100 * sizeof(double))) f = 460;
+
+    ojr_fill_beta(g1, a, b, x, 100);
+    for (i = 0; i < 100; ++i) {
+        y[i] = ojr_next_beta(g2, a, b);
+        if (! (x[i] >= 0.0 && x[i] <= 1.0)) f = 470;
+    }
+    if (0 != memcmp(x, y, 100 * sizeof(double))) f = 465;
+
+    ojr_fill_dirichlet(g1, alpha, k, x, 100);
+    for (i = 0; i < 100; ++i) {
+        ojr_next_dirichlet(g2, alpha, k, y + i * k);
+        for (sum = 0.0, j = 0; j < k; ++j) {
+            if (! (x[i * k + j] >= 0.0 && x[i * k + j] <= 1.0)) f = 480;
+            sum += x[i * k + j];
+        }
+        if (sum < 1.0 - 1e-9 || sum > 1.0 + 1e-9) f = 485;
+    }
+    if (0 != memcmp(x, y, 100 * k * sizeof(double))) f = 475;
+
+    ojr_close(g1);
+    ojr_close(g2);
+    return f;
+}
+
+// Permutations must be bijections, and ranges must match single elements.
+int permutations(void) {
+    int i, f = 0, count = ojr_rand(DEFGEN, 100);
+    int64_t n, start, out[100];
+    char *seen;
+    ojr_permutation *pp;
+
+    n = 1 + ojr_rand(DEFGEN, 2000);
+    if (NULL == (pp = ojr_permutation_new(DEFGEN, n))) return 350;
+    seen = calloc(n, 1);
+    for (i = 0; i < n; ++i) {
+        start = ojr_permutation_at(pp, i);
+        if (start < 0 || start >= n || seen[start]) f = 360;
+        else seen[start] = 1;
+    }
+    free(seen);
+    ojr_permutation_free(pp);
+
+    n = (int64_t)(ojr_next64(DEFGEN) >> (1 + ojr_rand(DEFGEN, 62)));
+    if (n < count) n = count + 1;
+    if (NULL == (pp = ojr_permutation_new(DEFGEN, n))) return 350;
+    start = (int64_t)ojr_rand64(DEFGEN, n - count + 1);
+    ojr_permutation_range(pp, start, out, count);
+    for (i = 0; i < count; ++i) {
+        if (out[i] != ojr_permutation_at(pp, start + i)) f = 370;
+    }
+    ojr_permutation_free(pp);
+    return f;
+}
+
+/* Bootstrap counts and multinomials must add up, indices must be in range,
+ * and replicates mustn't depend on the number of threads.
+ */
+int bootstraps(void) {
+    int i, k, f = 0, n = 1 + ojr_rand(DEFGEN, 50), seed = ojr_next32(DEFGEN);
+    int64_t t, a[50 * 4], b[50 * 4];
+    double p[50];
+    ojr_generator *g = ojr_open(ojr_algorithm_name(1 + ojr_rand(DEFGEN, 3)));
+
+    if (NULL == g) return 380;
+    ojr_bootstrap_counts(DEFGEN, n, a);
+    ojr_bootstrap_indices(DEFGEN, n, b);
+    for (t = 0, i = 0; i < n; ++i) {
+        if (a[i] < 0) f = 390;
+        if (b[i] < 0 || b[i] >= n) f = 390;
+        t += a[i];
+    }
+    if (t != n) f = 400;
+
+    for (i = 0; i < n; ++i) {
+        p[i] = ojr_rand(DEFGEN, 3) ? ojr_next_double(DEFGEN) : 0.0;
+    }
+    p[ojr_rand(DEFGEN, n)] = 1.0;
+    ojr_next_multinomial(DEFGEN, 1000, p, n, a);
+    for (t = 0, i = 0; i < n; ++i) {
+        if (a[i] < 0 || (0.0 == p[i] && 0 != a[i])) f = 390;
+        t += a[i];
+    }
+    if (t != 1000) f = 400;
+
+    ojr_int_seed(g, seed);
+    ojr_fill_bootstrap_counts(g, n, a, 4, 1);
+    ojr_int_seed(g, seed);
+    ojr_fill_bootstrap_counts(g, n, b, 4, 3);
+    for (k = 0; k < 4 * n; ++k) if (a[k] != b[k]) f = 410;
+
+    ojr_int_seed(g, seed);
+    ojr_fill_bootstrap_indices(g, n, a, 4, 2);
+    ojr_int_seed(g, seed);
+    ojr_fill_bootstrap_indices(g, n, b, 4, 0);
+    for (k = 0; k < 4 * n; ++k) if (a[k] != b[k]) f = 410;
+
+    ojr_close(g);
+    return f;
+}
+
 int fuzz(int count) {
     int i, test, sub, f = 0;
 
@@ -229,8 +567,24 @@ int fuzz(int count) {
             if (0 == sub) f = intseed();
             else if (1 == sub) f = arrayseed();
             else f = goodseed();
+        } else if (test < 90) {
+            f = ojr_rand(DEFGEN, 10) ? outoforder() : longstream();
+        } else if (test < 91) {
+            f = bootstraps();
+        } else if (test < 92) {
+            f = permutations();
+        } else if (test < 93) {
+            f = samples();
+        } else if (test < 94) {
+            f = ojr_rand(DEFGEN, 2) ? recordshuffle() : shuffletargets();
+        } else if (test < 95) {
+            f = gammas();
+        } else if (test < 96) {
+            f = withsum();
+        } else if (test < 98) {
+            f = deals();
         } else {
-            f = outoforder();
+            f = shuffles();
         }
         if (f) break;
     }
@@ -14,6 +14,7 @@
 #include <assert.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
 #include "ojrandlib.h"
 
@@ -24,7 +25,7 @@ static long iterations = 2000000;
 
 typedef struct _counter {
     int n;
-    long total, clipped;
+    long total, clipped, nans;
     double mn, mx, rw;
     char *test, *alg;
     long *counts;
@@ -56,7 +57,8 @@ if ((b) < 0 || (b) >= (c)->n) ++(c)->clipped; \
 else ++(c)->counts[b]; } while (0)
 
 #define INCV(c,v) do { ++(c)->total; \
-if ((v) <= (c)->mn || (v) >= (c)->mx) ++(c)->clipped; \
+if (isnan(v)) ++(c)->nans; \
+else if ((v) <= (c)->mn || (v) >= (c)->mx) ++(c)->clipped; \
 else ++(c)->counts[(int)(((v) - (c)->mn) * (c)->rw)]; } while (0)
 
 #define PI 3.1415926535897932385
@@ -143,51 +145,179 @@ static double igfq(double a, double x) {
     else return qcfrac(a, x);
 }
 
+static double betacf(double a, double b, double x) {
+    double c = 1.0, d, del, h, aa, m2;
+
+    d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < 1e-300) d = 1e-300;
+    h = d = 1.0 / d;
+    for (int m = 1; m <= PQITERATIONS; ++m) {
+        m2 = 2.0 * m;
+        aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < 1e-300) d = 1e-300;
+        c = 1.0 + aa / c;
+        if (fabs(c) < 1e-300) c = 1e-300;
+        h *= (d = 1.0 / d) * c;
+
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        if (fabs(d) < 1e-300) d = 1e-300;
+        c = 1.0 + aa / c;
+        if (fabs(c) < 1e-300) c = 1e-300;
+        h *= (del = (d = 1.0 / d) * c);
+        if (fabs(del - 1.0) < PQEPSILON) break;
+    }
+    return h;
+}
+
+// Regularized incomplete beta function, the beta CDF
+static double ibeta(double a, double b, double x) {
+    double lbt;
+
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    lbt = lngamma(a + b) - lngamma(a) - lngamma(b) +
+        a * log(x) + b * log1p(-x);
+    if (x < (a + 1.0) / (a + b + 2.0)) return exp(lbt) * betacf(a, b, x) / a;
+    return 1.0 - exp(lbt) * betacf(b, a, 1.0 - x) / b;
+}
+
+static double tcdf(double t, double nu) {
+    double p = 0.5 * ibeta(0.5 * nu, 0.5, nu / (nu + t * t));
+    return (t < 0.0) ? p : 1.0 - p;
+}
+
 static double normcdf(double z) {
     z *= ISQ2;
     if (z < 0.0) return 0.5 * igfq(0.5, z * z);
     else return 0.5 * (1.0 + igfp(0.5, z * z));
 }
 
+/* Buckets with zero expected value must be empty, and don't count. Runs of
+ * buckets with small expected values are pooled, since the chi-square test
+ * isn't valid for those on their own. Any NaN fails.
+ */
+#define POOLMIN 5.0
+
 static double pvalue(counter *c) {
-    double d, d2, ev, chi2 = 0.0;
+    int n = 0;
+    double d, ev, pev = 0.0, pcount = 0.0, hev = 0.0, hcount = 0.0;
+    double chi2 = 0.0;
+
+    if (c->nans) return 0.0;
     ev = (double)(c->total) / c->n;
 
     for (int i = 0; i < c->n; ++i) {
         if (c->ev) ev = c->ev[i];
-        d = (double)(c->counts[i]) - ev;
-        d2 = d * d;
-        chi2 += d2 / ev;
+        if (0.0 == ev && c->counts[i]) return 0.0;
+        pev += ev;
+        pcount += (double)(c->counts[i]);
+        if (pev < POOLMIN) continue;
+
+        // Hold each pooled cell until the next, so a short tail can join it
+        if (hev > 0.0) {
+            d = hcount - hev;
+            chi2 += d * d / hev;
+            ++n;
+        }
+        hev = pev;
+        hcount = pcount;
+        pev = pcount = 0.0;
+    }
+    hev += pev;
+    hcount += pcount;
+    if (hev > 0.0) {
+        d = hcount - hev;
+        chi2 += d * d / hev;
+        ++n;
     }
-    return igfq(0.5 * (c->n - 1), 0.5 * chi2);
+    if (n < 2) return 1.0;
+    return igfq(0.5 * (n - 1), 0.5 * chi2);
 }
 
 static double results(counter *c) {
     double pv = pvalue(c);
     printf("%10s%10s   n = %4d   p-value = %6.3f\n",
         c->alg, c->test, c->n, pv);
+    if (c->nans) printf("*** %ld NaNs ***\n", c->nans);
     if (pv < 0.0001) {
         printf("*** TEST FAILURE ***\n");
     }
     return pv;
 }
 
+// Half-Cauchy density, for testing user-defined ziggurats
+static double hcf(double x, void *a) { return 1.0 / (1.0 + x * x); }
+static double hcfinv(double y, void *a) { return sqrt(1.0 / y - 1.0); }
+static double hcarea(double r, void *a) { return 0.5 * PI - atan(r); }
+static double hctail(ojr_generator *g, double r, void *a) {
+    double t = atan(r);
+    return tan(t + ojr_next_double(g) * (0.5 * PI - t));
+}
+
 static int bsizes[] = { 7, 32, 52, 53, 65, 256, 1000 };
+static int decks[] = { 7, 32, 52, 53, 64 };
+static int zlayers[] = { 64, 128, 256, 1024, 4096 };
+static double gshapes[] = { 0.3, 1.0, 2.5, 7.0 };
+static double bshapes[] = { 0.005, 0.3, 1.0, 2.5, 7.0 };
+static double dofs[] = { 1.0, 2.5, 5.0, 30.0 };
 static char *testnames[] = {
-    "int.uni", "flt.uni", "sgn.uni", "sgn.nrm", "flt.exp"
+    "int.uni", "flt.uni", "sgn.uni", "sgn.nrm", "flt.exp", "zig.cau",
+    "flt.gam", "int.ali", "int.sum", "int.res", "int.dea",
+    "flt.bet", "flt.chi", "flt.stu", "flt.dir"
 };
 
+/* Betas with small shapes can round to exactly 0 or 1; count those in the
+ * end buckets.
+ */
+static double unit(double d) {
+    if (d <= 0.0) return DBL_MIN;
+    if (d >= 1.0) return nextafter(1.0, 0.0);
+    return d;
+}
+
 static int distribution_test(ojr_generator *g, int type) {
     int r, n;
-    double d, bw, left, right;
-
-    n = CHOOSE(bsizes);
+    double d, bw, left, right, shape = 0.0, shape2 = 0.0, fb[100], *w = NULL;
+    double alpha[4];
+    int k = 0;
+    int ib[100];
+    ojr_ziggurat *z;
+    ojr_alias *ap;
+    ojr_sumtree *tp;
+    ojr_reservoir *rp;
+
+    n = (10 == type) ? CHOOSE(decks) : CHOOSE(bsizes);
     counter *c = newcounter(n);
 
     if (1 == type) setrange(c, 0.0, 1.0);
     else if (2 == type) setrange(c, -1.0, 1.0);
     else if (3 == type) setrange(c, -3.0, 3.0);
-    else if (4 == type) setrange(c, 0.0, 10.0);
+    else if (4 == type || 5 == type) setrange(c, 0.0, 10.0);
+    else if (6 == type) {
+        shape = CHOOSE(gshapes);
+        setrange(c, 0.0, shape + 6.0 * sqrt(shape));
+    } else if (11 == type) {
+        shape = CHOOSE(bshapes);
+        shape2 = CHOOSE(bshapes);
+        setrange(c, 0.0, 1.0);
+    } else if (12 == type) {
+        shape = CHOOSE(dofs);
+        setrange(c, 0.0, shape + 6.0 * sqrt(2.0 * shape));
+    } else if (13 == type) {
+        shape = CHOOSE(dofs);
+        setrange(c, -4.0, 4.0);
+    } else if (14 == type) {
+        // The first component is beta(alpha[0], sum of the others)
+        k = 2 + ojr_rand(DEFGEN, 3);
+        for (int i = 0; i < k; ++i) {
+            alpha[i] = CHOOSE(bshapes);
+            if (i) shape2 += alpha[i];
+        }
+        shape = alpha[0];
+        setrange(c, 0.0, 1.0);
+    }
 
     switch (type) {
     case 0:
@@ -209,17 +339,180 @@ static int distribution_test(ojr_generator *g, int type) {
         }
         break;
     case 3:
+        ojr_set_normal_layers(g, CHOOSE(zlayers));
         for (long i = 0; i < iterations; ++i) {
             d = ojr_next_normal(g);
             INCV(c, d);
         }
         break;
     case 4:
+        ojr_set_exponential_layers(g, CHOOSE(zlayers));
         for (long i = 0; i < iterations; ++i) {
             d = ojr_next_exponential(g);
             INCV(c, d);
         }
         break;
+    case 5:
+        z = ojr_ziggurat_new(CHOOSE(zlayers), 0, hcf, hcfinv,
+            ojr_rand(g, 2) ? hcarea : NULL, hctail, NULL);
+        assert(NULL != z);
+        for (long i = 0; i < iterations; i += 100) {
+            ojr_fill_ziggurat(g, z, fb, 100);
+            for (int j = 0; j < 100; ++j) INCV(c, fb[j]);
+        }
+        ojr_ziggurat_free(z);
+        break;
+    case 7:
+        // Random weights, with some zeros
+        w = calloc(n, sizeof(double));
+        for (int i = 0; i < n; ++i) {
+            if (ojr_rand(g, 8)) w[i] = 0.1 + ojr_next_double(g);
+        }
+        w[ojr_rand(g, n)] = 1.0;
+        ap = ojr_alias_new(w, n);
+        assert(NULL != ap);
+        for (long i = 0; i < iterations; i += 100) {
+            ojr_fill_alias(g, ap, ib, 100);
+            for (int j = 0; j < 100; ++j) INC(c, ib[j]);
+        }
+        ojr_alias_free(ap);
+        break;
+    case 8:
+        // Start with some weights, then change half of them
+        w = calloc(n, sizeof(double));
+        for (int i = 0; i < n; ++i) w[i] = 0.1 + ojr_next_double(g);
+        tp = ojr_sumtree_new(w, n);
+        assert(NULL != tp);
+        for (int i = 0; i < n; ++i) {
+            r = ojr_rand(g, n);
+            w[r] = ojr_rand(g, 4) ? 0.1 + ojr_next_double(g) : 0.0;
+            ojr_sumtree_update(tp, r, w[r]);
+        }
+        for (long i = 0; i < iterations; ++i) {
+            r = ojr_next_sumtree(g, tp);
+            INC(c, r);
+        }
+        ojr_sumtree_free(tp);
+        break;
+    case 9:
+        /* Unweighted reservoirs count how often each item of the stream is
+         * kept, sometimes skipping; weighted ones keep only one item so its
+         * probability is proportional to its weight.
+         */
+        w = calloc(n, sizeof(double));
+        if (ojr_rand(g, 2)) {
+            int k = n / 16 + 1, skip = ojr_rand(g, 2);
+            for (int i = 0; i < n; ++i) w[i] = 1.0;
+            for (long i = 0; i < iterations; i += k) {
+                rp = ojr_reservoir_new(k, 0);
+                for (int j = 0; j < n; ++j) {
+                    int64_t s = skip ? ojr_reservoir_skip(rp) : 0;
+                    if (s >= n - j) break;
+                    j += (int)s;
+                    if ((r = ojr_reservoir_offer(g, rp)) >= 0) ib[r] = j;
+                }
+                for (int j = 0; j < k; ++j) INC(c, ib[j]);
+                ojr_reservoir_free(rp);
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                if (ojr_rand(g, 8)) w[i] = 0.1 + ojr_next_double(g);
+            }
+            w[ojr_rand(g, n)] = 1.0;
+            for (long i = 0; i < iterations / n + 50 * n; ++i) {
+                rp = ojr_reservoir_new(1, 1);
+                for (int j = 0; j < n; ++j) {
+                    if (0 == ojr_reservoir_offer_weighted(g, rp, w[j])) r = j;
+                }
+                INC(c, r);
+                ojr_reservoir_free(rp);
+            }
+        }
+        break;
+    case 10:
+        // Count the cards in the last of several hands
+        {
+            int sizes[4], nh = 1 + ojr_rand(g, 4);
+            uint64_t hands[400];
+
+            w = calloc(n, sizeof(double));
+            for (int i = 0; i < n; ++i) w[i] = 1.0;
+            for (int i = 0; i < nh; ++i) sizes[i] = 1 + ojr_rand(g, n / nh);
+            for (long i = 0; i < iterations; i += 100 * sizes[nh - 1]) {
+                ojr_fill_deal(g, n, sizes, nh, hands, 100);
+                for (int j = 0; j < 100; ++j) {
+                    for (int k = 0; k < n; ++k) {
+                        if (hands[j * nh + nh - 1] & (1ULL << k)) INC(c, k);
+                    }
+                }
+            }
+        }
+        break;
+    case 6:
+        if (ojr_rand(g, 2)) {
+            for (long i = 0; i < iterations; ++i) {
+                d = ojr_next_gamma(g, shape, 1.0);
+                INCV(c, d);
+            }
+        } else {
+            for (long i = 0; i < iterations; i += 100) {
+                ojr_fill_gamma(g, shape, 1.0, fb, 100);
+                for (int j = 0; j < 100; ++j) INCV(c, fb[j]);
+            }
+        }
+        break;
+    case 11:
+        if (ojr_rand(g, 2)) {
+            for (long i = 0; i < iterations; ++i) {
+                d = ojr_next_beta(g, shape, shape2);
+                INCV(c, unit(d));
+            }
+        } else {
+            for (long i = 0; i < iterations; i += 100) {
+                ojr_fill_beta(g, shape, shape2, fb, 100);
+                for (int j = 0; j < 100; ++j) INCV(c, unit(fb[j]));
+            }
+        }
+        break;
+    case 12:
+        if (ojr_rand(g, 2)) {
+            for (long i = 0; i < iterations; ++i) {
+                d = ojr_next_chisquare(g, shape);
+                INCV(c, d);
+            }
+        } else {
+            for (long i = 0; i < iterations; i += 100) {
+                ojr_fill_chisquare(g, shape, fb, 100);
+                for (int j = 0; j < 100; ++j) INCV(c, fb[j]);
+            }
+        }
+        break;
+    case 13:
+        if (ojr_rand(g, 2)) {
+            for (long i = 0; i < iterations; ++i) {
+                d = ojr_next_student_t(g, shape);
+                INCV(c, d);
+            }
+        } else {
+            for (long i = 0; i < iterations; i += 100) {
+                ojr_fill_student_t(g, shape, fb, 100);
+                for (int j = 0; j < 100; ++j) INCV(c, fb[j]);
+            }
+        }
+        break;
+    case 14:
+        if (ojr_rand(g, 2)) {
+            for (long i = 0; i < iterations; ++i) {
+                ojr_next_dirichlet(g, alpha, k, fb);
+                INCV(c, unit(fb[0]));
+            }
+        } else {
+            for (long i = 0; i < iterations; i += 100 / k) {
+                ojr_fill_dirichlet(g, alpha, k, fb, 100 / k);
+                for (int j = 0; j < 100 / k; ++j) INCV(c, unit(fb[j * k]));
+            }
+        }
+        break;
     }
     c->alg = ojr_algorithm_name(g->algorithm);
     c->test = testnames[type];
@@ -244,12 +537,147 @@ static int distribution_test(ojr_generator *g, int type) {
             c->ev[i] = c->total * (right - left);
             left = right;
         }
+    } else if (5 == type) {
+        left = 0.0;
+        for (int i = 0; i < c->n; ++i) {
+            right = atan(bw * (i + 1)) / (0.5 * PI);
+            c->ev[i] = c->total * (right - left);
+            left = right;
+        }
+    } else if (6 == type) {
+        left = 0.0;
+        for (int i = 0; i < c->n; ++i) {
+            right = igfp(shape, bw * (i + 1));
+            c->ev[i] = c->total * (right - left);
+            left = right;
+        }
+    } else if (11 == type || 14 == type) {
+        left = 0.0;
+        for (int i = 0; i < c->n; ++i) {
+            right = ibeta(shape, shape2, bw * (i + 1));
+            c->ev[i] = c->total * (right - left);
+            left = right;
+        }
+    } else if (12 == type) {
+        left = 0.0;
+        for (int i = 0; i < c->n; ++i) {
+            right = igfp(0.5 * shape, 0.5 * bw * (i + 1));
+            c->ev[i] = c->total * (right - left);
+            left = right;
+        }
+    } else if (13 == type) {
+        left = tcdf(c->mn, shape);
+        for (int i = 0; i < c->n; ++i) {
+            right = tcdf(c->mn + bw * (i + 1), shape);
+            c->ev[i] = c->total * (right - left);
+            left = right;
+        }
+    } else if (type >= 7) {
+        d = 0.0;
+        for (int i = 0; i < c->n; ++i) d += w[i];
+        for (int i = 0; i < c->n; ++i) c->ev[i] = c->total * w[i] / d;
+        free(w);
+    }
+    double pv = results(c);
+    closecounter(c);
+    return (pv < 0.001);
+}
+
+/* Poisson, binomial, geometric and negative binomial counts over a range
+ * of +/- 4 standard deviations, where expected counts are large enough for
+ * the chi-square test.
+ */
+static double pmeans[] = { 0.7, 4.0, 25.0, 250.0, 1e6 };
+static double bprobs[] = { 0.01, 0.2, 0.5, 0.93 };
+static int bcounts[] = { 20, 300, 5000, 1000000 };
+static double gprobs[] = { 0.01, 0.2, 0.5, 0.9, 0.999 };
+static double nbcounts[] = { 0.5, 1.0, 3.0, 20.0 };
+static char *dnames[] = { "int.poi", "int.bin", "int.geo", "int.nbi" };
+
+static double logpmf(int type, int64_t k, double mean, int64_t bn,
+double p, double r) {
+    if (0 == type) return k * log(mean) - mean - lngamma(k + 1.0);
+    if (1 == type) return lngamma(bn + 1.0) - lngamma(k + 1.0) -
+        lngamma(bn - k + 1.0) + k * log(p) + (bn - k) * log1p(-p);
+    return lngamma(k + r) - lngamma(k + 1.0) - lngamma(r) +
+        r * log(p) + k * log1p(-p);
+}
+
+// Counts outside the range go in the end buckets, so no cell is hidden.
+static inline int dbucket(int64_t k, int lo, int n) {
+    if (k < lo) return 0;
+    if (k - lo >= n) return n - 1;
+    return (int)(k - lo);
+}
+
+static int discrete_test(ojr_generator *g, int type) {
+    int n, lo;
+    int64_t k, bn = 0, kb[100];
+    double mean, sd, p = 0.0, r = 1.0, sum;
+    ojr_poisson pp;
+    ojr_binomial bp;
+
+    if (0 == type) {
+        mean = CHOOSE(pmeans);
+        sd = sqrt(mean);
+        ojr_poisson_init(&pp, mean);
+    } else if (1 == type) {
+        bn = CHOOSE(bcounts);
+        p = CHOOSE(bprobs);
+        mean = bn * p;
+        sd = sqrt(mean * (1.0 - p));
+        ojr_binomial_init(&bp, bn, p);
+    } else {
+        // Geometric is negative binomial with r = 1
+        if (3 == type) r = CHOOSE(nbcounts);
+        p = CHOOSE(gprobs);
+        mean = r * (1.0 - p) / p;
+        sd = sqrt(mean / p);
     }
+    lo = (int)floor(mean - 4.0 * sd);
+    if (lo < 0) lo = 0;
+    n = (int)ceil(mean + 4.0 * sd) + 1 - lo;
+    if (0 != bn && lo + n > bn + 1) n = bn + 1 - lo;
+    if (n < 2) return 0;
+
+    counter *c = newcounter(n);
+    if (type < 2) {
+        for (long i = 0; i < iterations; ++i) {
+            k = type ? ojr_next_binomial(g, &bp) : ojr_next_poisson(g, &pp);
+            INC(c, dbucket(k, lo, n));
+        }
+    } else if (ojr_rand(g, 2)) {
+        for (long i = 0; i < iterations; ++i) {
+            k = (2 == type) ? ojr_next_geometric(g, p) :
+                ojr_next_negative_binomial(g, r, p);
+            INC(c, dbucket(k, lo, n));
+        }
+    } else {
+        for (long i = 0; i < iterations; i += 100) {
+            if (2 == type) ojr_fill_geometric(g, p, kb, 100);
+            else ojr_fill_negative_binomial(g, r, p, kb, 100);
+            for (int j = 0; j < 100; ++j) INC(c, dbucket(kb[j], lo, n));
+        }
+    }
+    c->alg = ojr_algorithm_name(g->algorithm);
+    c->test = dnames[type];
+    c->ev = calloc(c->n, sizeof(double));
+
+    sum = 0.0;
+    for (k = 0; k < lo; ++k) sum += exp(logpmf(type, k, mean, bn, p, r));
+    for (int i = 0; i < n - 1; ++i) {
+        sum += exp(logpmf(type, lo + i, mean, bn, p, r));
+        c->ev[i] = c->total * sum;
+        sum = 0.0;
+    }
+    for (int i = 0; i < n - 1; ++i) sum += c->ev[i];
+    c->ev[n - 1] = (sum < c->total) ? c->total - sum : 0.0;
     double pv = results(c);
     closecounter(c);
     return (pv < 0.001);
 }
 
+static int ctypes[] = { 6, 11, 12, 13, 14 };
 static ojr_generator *gens[ACOUNT];
 
 int loop(int count) {
@@ -269,10 +697,20 @@ int loop(int count) {
             f = distribution_test(g, 1);
         } else if (t < 70) {
             f = distribution_test(g, 2);
-        } else if (t < 85) {
+        } else if (t < 80) {
             f = distribution_test(g, 3);
-        } else if (t < 100) {
+        } else if (t < 90) {
             f = distribution_test(g, 4);
+        } else if (t < 94) {
+            f = distribution_test(g, 5);
+        } else if (t < 96) {
+            f = distribution_test(g, CHOOSE(ctypes));
+        } else if (t < 98) {
+            f = distribution_test(g, 7 + ojr_rand(DEFGEN, 4));
+        } else if (t < 99) {
+            f = discrete_test(g, ojr_rand(DEFGEN, 2));
+        } else if (t < 100) {
+            f = discrete_test(g, 2 + ojr_rand(DEFGEN, 2));
         }
         if (f) break;
     }
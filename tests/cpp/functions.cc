@@ -0,0 +1,308 @@
+/* OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+ *
+ * To the extent possibile under law, Lee Daniel Crocker has waived all
+ * copyright and related or neighboring rights to this work.
+ * <http://creativecommons.org/publicdomain/zero/1.0/>
+ *
+ * Test the C++ classes against the C library.
+ */
+
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+
+#include "ojrandlib.h"
+using namespace oj;
+
+/* An engine must give the same stream as the C generator of the same
+ * algorithm, seeded the same way, with mixed word sizes. Reseeding leaves
+ * what's buffered alone, so streams agree after one only if the buffers
+ * are the same size.
+ */
+template<typename E>
+int enginestream(const char *name, int reseed) {
+    uint32_t seed[20], more[3];
+    int i, f = 0, size = 1 + ojr_rand(DEFGEN, 20);
+    ojr_generator *g = ojr_open(name);
+    E e;
+
+    if (NULL == g) return 100;
+    for (i = 0; i < size; ++i) seed[i] = ojr_next32(DEFGEN);
+    for (i = 0; i < 3; ++i) more[i] = ojr_next32(DEFGEN);
+
+    if (ojr_rand(DEFGEN, 4)) {
+        ojr_array_seed(g, seed, size);
+        e.seed(seed, size);
+    } else {
+        ojr_int_seed(g, (int)seed[0]);
+        e.seed((int)seed[0]);
+    }
+    for (i = 0; i < 3000 && 0 == f; ++i) {
+        if (1000 == i && reseed) {
+            ojr_reseed(g, more, 3);
+            e.reseed(more, 3);
+        }
+        switch (ojr_rand(DEFGEN, 4)) {
+        case 0: if (ojr_next64(g) != e.next64()) f = 110; break;
+        case 1: if (ojr_next_double(g) != e.nextDouble()) f = 120; break;
+        default: if (ojr_next32(g) != e()) f = 130; break;
+        }
+    }
+    ojr_discard(g, 777);
+    e.discard(777);
+    if (ojr_next32(g) != e.next32()) f = 140;
+
+    ojr_close(g);
+    return f;
+}
+
+int engines(void) {
+    int f;
+
+    if ((f = enginestream<Engine<JKISS127> >("jkiss127", 1))) return f;
+    if ((f = enginestream<Engine<JKISS127, 7> >("jkiss127", 0))) return f;
+    if ((f = enginestream<Engine<MT19937> >("mt19937", 1))) return f;
+    if ((f = enginestream<Engine<MWC8222> >("mwc8222", 1))) return f;
+    return 0;
+}
+
+#if __cplusplus >= 201402L
+/* Tables computed at compile time must match the C generators at run time.
+ * The seeds are fixed, as they have to be constants.
+ */
+template<typename T, int N, typename Algorithm>
+int tablestream(const char *name, const Table<T, N> &t, int seed) {
+    int i, f = 0;
+    ojr_generator *g = ojr_open(name);
+
+    if (NULL == g) return 150;
+    ojr_int_seed(g, seed);
+    for (i = 0; i < N; ++i) {
+        if (t[i] != ((sizeof(T) > 4) ? (T)ojr_next64(g) : (T)ojr_next32(g)))
+            f = 160;
+    }
+    ojr_close(g);
+    return f;
+}
+
+constexpr Table<uint32_t, 300> jktable = randomTable<uint32_t, 300>(7);
+constexpr Table<uint64_t, 700> mttable =
+    randomTable<uint64_t, 700, MT19937>(42);
+constexpr Table<uint32_t, 600> mwctable =
+    randomTable<uint32_t, 600, MWC8222>(-5);
+
+int tables(void) {
+    int f;
+
+    if ((f = tablestream<uint32_t, 300, JKISS127>("jkiss127", jktable, 7)))
+        return f;
+    if ((f = tablestream<uint64_t, 700, MT19937>("mt19937", mttable, 42)))
+        return f;
+    return tablestream<uint32_t, 600, MWC8222>("mwc8222", mwctable, -5);
+}
+#else
+int tables(void) { return 0; }
+#endif
+
+/* Generators must survive being moved around, clones must be independent
+ * copies, and every way of seeding must agree.
+ */
+int generators(void) {
+    int i, f = 0;
+    uint32_t seed[16];
+    std::vector<Generator> gens;
+    Generator a("mt19937");
+
+    for (i = 0; i < 16; ++i) seed[i] = ojr_next32(DEFGEN);
+    for (i = 0; i < 10; ++i) {
+        gens.push_back(Generator(ojr_algorithm_name(1 + i % 3)));
+    }
+    a.seed(seed, 16);
+    a.discard(ojr_rand(DEFGEN, 1000));
+
+    Generator b = a.clone();
+    for (i = 0; i < 1000; ++i) if (a.next32() != b.next32()) f = 200;
+    a.next16();
+    b.next16();
+    if (a.next16() != b.next16()) f = 200;
+
+    gens[3] = std::move(a);
+    Generator c(std::move(gens[3]));
+    for (i = 0; i < 100; ++i) if (c.next32() != b.next32()) f = 210;
+
+    Seed v(seed, seed + 16);
+    c.seed(v);
+    b.seed(v.begin(), v.end());
+    for (i = 0; i < 100; ++i) if (c.next32() != b.next32()) f = 220;
+    c.seed(seed, seed + 16);
+    b.seed(seed, 16);
+    c.reseed(v);
+    b.reseed(seed, 16);
+    for (i = 0; i < 100; ++i) if (c.next32() != b.next32()) f = 220;
+    return f;
+}
+
+// Bulk fills, and views made from them, must match single draws.
+int fills(void) {
+    int i, f = 0;
+    uint32_t limit = 1 + ojr_next32(DEFGEN) % 1000, r[500];
+    double d[500];
+    Generator a("jkiss127");
+    Generator b = a.clone();
+
+    a.fillDouble(d, 500);
+    for (i = 0; i < 500; ++i) if (d[i] != b.nextDouble()) f = 300;
+    a.fillRand(limit, r, 500);
+    for (i = 0; i < 500; ++i) if (r[i] >= limit) f = 310;
+
+#if defined(__cpp_lib_ranges)
+    std::vector<double> v;
+    b = a.clone();
+    std::ranges::copy(views::uniform(a) | std::views::take(1000),
+        std::back_inserter(v));
+    for (i = 0; i < 1000; ++i) if (v[i] != b.nextDouble()) f = 320;
+
+    // Values stepped over are drawn all the same.
+    v.clear();
+    b = a.clone();
+    std::ranges::copy(views::uniform(a) | std::views::drop(300) |
+        std::views::take(5), std::back_inserter(v));
+    for (i = 0; i < 300; ++i) b.nextDouble();
+    for (i = 0; i < 5; ++i) if (v[i] != b.nextDouble()) f = 320;
+#endif
+    return f;
+}
+
+/* Distribution objects must draw what the library does, one at a time or
+ * filled, and uniforms from an Engine must match those from a Generator.
+ */
+int distributions(void) {
+    int i, f = 0;
+    int32_t lo = (int32_t)(ojr_next32(DEFGEN) >> 2), ia[500], ib[500];
+    uint32_t r[500], range = 1 + ojr_next32(DEFGEN) % 100000;
+    int64_t ka[200], kb[200];
+    double da[500], db[500];
+    Generator a("jkiss127");
+    Generator b = a.clone();
+    Engine<JKISS127> e(77);
+    UniformInt ui(lo, lo + (int32_t)range - 1);
+    UniformReal ur(-3.0, 5.0);
+    Normal nd(10.0, 2.0);
+    Exponential ed(4.0);
+    Poisson pd(3.5);
+    Binomial bd(1000, 0.3);
+
+    for (i = 0; i < 500; ++i) ia[i] = ui(a);
+    b.fillRand(range, r, 500);
+    for (i = 0; i < 500; ++i) {
+        if (ia[i] != (int32_t)((uint32_t)lo + r[i])) f = 400;
+    }
+    ui.fill(a, ia, 500);
+    for (i = 0; i < 500; ++i) if (ia[i] != ui(b)) f = 400;
+
+    ur.fill(a, da, 500);
+    for (i = 0; i < 500; ++i) {
+        if (da[i] != -3.0 + 8.0 * b.nextDouble()) f = 410;
+        if (da[i] < -3.0 || da[i] >= 5.0) f = 410;
+    }
+    nd.fill(a, da, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != nd(b)) f = 420;
+    ed.fill(a, da, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != 4.0 * b.nextExponential()) f = 420;
+
+    pd.fill(a, ka, 200);
+    for (i = 0; i < 200; ++i) if (ka[i] != pd(b)) f = 430;
+    bd.fill(a, kb, 200);
+    for (i = 0; i < 200; ++i) {
+        if (kb[i] != bd(b) || kb[i] < 0 || kb[i] > 1000) f = 430;
+    }
+
+    a.seed(77);
+    ui.fill(e, ib, 500);
+    ur.fill(e, db, 500);
+    for (i = 0; i < 500; ++i) if (ib[i] != ui(a)) f = 440;
+    for (i = 0; i < 500; ++i) if (db[i] != ur(a)) f = 440;
+
+#if __cplusplus >= 202002L && defined(__cpp_lib_span)
+    // Span overloads must do just what the pointer ones do.
+    uint32_t seed[5] = { 1, 2, 3, 4, 5 };
+    a.seed(std::span<const uint32_t>(seed));
+    b.seed(seed, 5);
+    for (i = 0; i < 100; ++i) if (a.next32() != b.next32()) f = 450;
+
+    ui.fill(a, std::span<int32_t>(ia));
+    ui.fill(b, ib, 500);
+    for (i = 0; i < 500; ++i) if (ia[i] != ib[i]) f = 450;
+    ur.fill(a, std::span<double>(da));
+    ur.fill(b, db, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != db[i]) f = 450;
+    nd.fill(a, std::span<double>(da));
+    nd.fill(b, db, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != db[i]) f = 450;
+    ed.fill(a, std::span<double>(da));
+    ed.fill(b, db, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != db[i]) f = 450;
+    pd.fill(a, std::span<int64_t>(ka));
+    pd.fill(b, kb, 200);
+    for (i = 0; i < 200; ++i) if (ka[i] != kb[i]) f = 450;
+    bd.fill(a, std::span<int64_t>(ka));
+    bd.fill(b, kb, 200);
+    for (i = 0; i < 200; ++i) if (ka[i] != kb[i]) f = 450;
+
+    Engine<JKISS127> e2(e);
+    ui.fill(e, std::span<int32_t>(ia));
+    ui.fill(e2, ib, 500);
+    for (i = 0; i < 500; ++i) if (ia[i] != ib[i]) f = 450;
+    ur.fill(e, std::span<double>(da));
+    ur.fill(e2, db, 500);
+    for (i = 0; i < 500; ++i) if (da[i] != db[i]) f = 450;
+#endif
+    return f;
+}
+
+/* Generator::shuffle() must give the same permutation as ojr_shuffle()
+ * from the same stream, for sizes and counts around the batch size.
+ */
+int shuffles(void) {
+    int i, j, f = 0, size, count;
+    uint32_t seed[4];
+
+    for (i = 0; i < 10 && 0 == f; ++i) {
+        const char *name = ojr_algorithm_name(1 + ojr_rand(DEFGEN, 3));
+        ojr_generator *g = ojr_open(name);
+        Generator e(name);
+
+        size = ojr_rand(DEFGEN, 2) ? ojr_rand(DEFGEN, 4 * OJR_SHUFFLE_BATCH) :
+            ojr_rand(DEFGEN, 5000);
+        count = ojr_rand(DEFGEN, size + 1);
+        for (j = 0; j < 4; ++j) seed[j] = ojr_next32(DEFGEN);
+        ojr_array_seed(g, seed, 4);
+        e.seed(seed, 4);
+
+        std::vector<int> a(size), b(size);
+        for (j = 0; j < size; ++j) a[j] = b[j] = j;
+        if (size > 0) ojr_shuffle(g, &a[0], size, sizeof(int), count);
+        e.shuffle(b, count);
+        if (a != b) f = 500;
+        if (ojr_next32(g) != e.next32()) f = 510;
+        ojr_close(g);
+    }
+    return f;
+}
+
+int main(int argc, char *argv[]) {
+    int i, f = 0;
+
+    for (i = 0; i < 20 && 0 == f; ++i) {
+        f = engines();
+        if (0 == f) f = tables();
+        if (0 == f) f = generators();
+        if (0 == f) f = fills();
+        if (0 == f) f = distributions();
+        if (0 == f) f = shuffles();
+    }
+    printf("C++ functions test %sed.\n", f ? "fail" : "pass");
+    if (f) printf("Error code: %d\n", f);
+
+    return f ? EXIT_FAILURE : EXIT_SUCCESS;
+}
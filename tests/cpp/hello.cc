@@ -8,6 +8,7 @@
  */
 
 #include <iostream>
+#include <random>
 using namespace std;
 
 #include "ojrandlib.h"
@@ -23,5 +24,12 @@ int main(int argc, char *argv[]) {
     cout << "  " << g.rand(100) << "  " << g.next16()     <<
             "  " << g.next32()  << "  " << g.nextDouble() << "\n";
 
+    // Generators work with the standard distributions too.
+    uniform_int_distribution<int> die(1, 6);
+    Generator64 g64(g);
+    uniform_real_distribution<double> unit;
+
+    cout << "  " << die(g) << "  " << unit(g64) << "\n";
+
     return 0;
 }
@@ -22,5 +22,35 @@ public class Hello {
             System.out.printf("%12d ", g.next32());
             if (4 == (i % 5)) System.out.printf("\n");
         }
+        checkStream(g);
+    }
+
+    /* The buffered draws in Java must give the same stream as the C
+     * library. Expected values are from the same calls made in C.
+     */
+    private static void checkStream(Generator g) {
+        long x = 0;
+        double d = 0.0;
+        int i;
+
+        g.seed(gSeed);
+        for (i = 0; i < 3; ++i) x ^= g.next32() & 0xFFFFFFFFL;
+        for (i = 0; i < 1000; ++i) {
+            x = (x << 1 | x >>> 63) ^ g.next64();
+            d += g.nextDouble();
+            d += g.nextNormal();
+            x ^= g.next32() & 0xFFFFFFFFL;
+        }
+        assert 0xd0ee522f15036d1eL == x;
+        assert 0x1.059a3ba72906p+9 == d;
+
+        // next64() with one word left in the buffer
+        g.seed(gSeed);
+        for (i = 0; i < 623; ++i) g.next32();
+        assert 0x089b5f90e09d5b09L == g.next64();
+
+        g.seed(12345);
+        assert 0xedfb51e2 == g.next32();
+        System.out.printf("Stream check passed.\n");
     }
 }
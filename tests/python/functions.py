@@ -0,0 +1,167 @@
+#!/usr/bin/python3
+#
+# OneJoker RNG library <http://lcrocker.github.io/onejoker/randlib>
+#
+# To the extent possibile under law, Lee Daniel Crocker has waived all
+# copyright and related or neighboring rights to this work.
+# <http://creativecommons.org/publicdomain/zero/1.0/>
+#
+# Test the basic functions of the Python module.
+#
+
+import sys, os, array, threading
+sys.path.insert(1, ".")
+
+import ojrandlib as rl
+
+anames = [ "jkiss127", "mt19937", "mwc8222" ]
+seed = [ 0x12345678, 0x9ABCDEF0, 0x0F1E2D3C ]
+
+def generators():
+    for name in anames:
+        a, b = rl.Generator(name), rl.Generator(name)
+        a.seed(seed)
+        b.seed(seed)
+        yield a, b
+
+# Bulk fills give the same values, in the same order, as single draws.
+
+def fills():
+    for a, b in generators():
+        x = array.array("I", [0]) * 1000
+        a.fill32(x)
+        if list(x) != [b.next32() & 0xFFFFFFFF for i in range(1000)]:
+            return 10
+        x = array.array("Q", [0]) * 1000
+        a.fill64(x)
+        if list(x) != [b.next64() & 0xFFFFFFFFFFFFFFFF for i in range(1000)]:
+            return 20
+        x = array.array("d", [0.0]) * 1000
+        a.fill_double(x)
+        if list(x) != [b.next_double() for i in range(1000)]:
+            return 30
+        x = array.array("d", [0.0]) * 1000
+        a.fill_normal(x)
+        if list(x) != [b.next_normal() for i in range(1000)]:
+            return 40
+
+        # Nothing to fill, so nothing drawn
+        if a.fill32(bytearray()) != bytearray():
+            return 50
+        if a.fill_double(array.array("d")) != array.array("d"):
+            return 51
+        if a.next32() != b.next32():
+            return 52
+
+        try:
+            a.fill32(bytes(16))
+            return 60
+        except TypeError:
+            pass
+    return 0
+
+# NumPy draws straight from our generators, so it sees the same stream.
+
+def numpy_rng():
+    if rl.numpy is None:
+        print("NumPy not available; skipping NumPy test.")
+        return 0
+
+    for name in anames:
+        b = rl.Generator(name)
+        b.seed(seed)
+        x = rl.default_rng(name, seed).random(1000)
+        if list(x) != [b.next_double() for i in range(1000)]:
+            return 110
+
+        a = rl.BitGenerator(name, seed)
+        b.seed(seed)
+        if a.random_raw() != b.next64() & 0xFFFFFFFFFFFFFFFF:
+            return 120
+        x = a.random_raw(100)
+        if list(x) != [b.next64() & 0xFFFFFFFFFFFFFFFF for i in range(100)]:
+            return 121
+        if a.random_raw(10, output = False) is not None:
+            return 122
+        for i in range(10):
+            b.next64()
+        if a.random_raw() != b.next64() & 0xFFFFFFFFFFFFFFFF:
+            return 123
+    return 0
+
+# random.Random on our generators: seeded streams repeat, each thread
+# gets its own, and the bit and byte functions handle their edge cases.
+
+def ojrandom():
+    for name in anames:
+        a, b = rl.OJRandom(12345, name), rl.OJRandom(12345, name)
+        x = [a.random() for i in range(2000)]
+        if x != [b.random() for i in range(2000)]:
+            return 210
+        if [a.getrandbits(32) for i in range(100)] != \
+            [b.getrandbits(32) for i in range(100)]:
+            return 211
+        if rl.OJRandom(12346, name).random() == rl.OJRandom(12345,
+            name).random():
+            return 212
+
+        if 0 != a.getrandbits(0):
+            return 220
+        for k in (1, 31, 32, 33, 64, 100):
+            if any(a.getrandbits(k) >> k for i in range(200)):
+                return 221
+        if not any(a.getrandbits(100) >> 96 for i in range(200)):
+            return 222
+        try:
+            a.getrandbits(-1)
+            return 223
+        except ValueError:
+            pass
+
+        if b"" != a.randbytes(0):
+            return 230
+        for n in (1, 3, 4 * a.CHUNK - 1, 4 * a.CHUNK + 5, 10000):
+            if n != len(a.randbytes(n)):
+                return 231
+
+        try:
+            a.getstate()
+            return 240
+        except NotImplementedError:
+            pass
+
+        # Seeds of any accepted type by value; other types refused
+        if rl.OJRandom(3.5, name).random() == rl.OJRandom(3, name).random():
+            return 245
+        if rl.OJRandom(3.0, name).random() != rl.OJRandom(3, name).random():
+            return 246
+        try:
+            rl.OJRandom([1, 2], name)
+            return 247
+        except TypeError:
+            pass
+
+    # One stream per thread, and no seed's thread shares another's
+    r = [rl.OJRandom(0), rl.OJRandom(1 << 32)]
+    out = {}
+
+    def draw(i):
+        for j, g in enumerate(r):
+            out[(i, j)] = tuple(g.getrandbits(32) for k in range(8))
+    for i in range(3):
+        t = threading.Thread(target = draw, args = (i,))
+        t.start()
+        t.join()
+    if len(set(out.values())) != len(out):
+        return 250
+    return 0
+
+def main():
+    f = fills() or numpy_rng() or ojrandom()
+    print("Python functions test {}ed.".format("fail" if f else "pass"))
+    if f:
+        print("Error code: {}".format(f))
+    return 1 if f else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
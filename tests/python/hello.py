@@ -19,3 +19,6 @@ g.seed()
 
 print("  {:d}".format(g.rand(100)), " {:d}".format(g.next16()), end="")
 print(" {:d}".format(g.next32()), " {:f}".format(g.next_double()))
+
+d = g.array_double(4)
+print("  " + " ".join("{:f}".format(x) for x in d))